@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""
+Compile-time benchmark of the grammars.
+
+Compiles every translation unit of monster, problem_1..8, not_nice_1..4 and
+the variants of bench_erased (one per parser boundary) with each of the given
+compilers and writes one CSV row per unit with the wall
+time, the peak RSS, the object size and, for clang, the number of template
+instantiations aggregated from the -ftime-trace JSON.
+
+Many of the problems are expected not to compile, their rows are kept with a
+"failed" status so that the numbers remain comparable over time.
+"""
+
+import argparse
+import csv
+import glob
+import json
+import os
+import re
+import shlex
+import shutil
+import subprocess
+import sys
+import time
+
+TARGETS = (
+    ["monster"]
+    + ["problem_%d" % i for i in range(1, 9)]
+    + ["not_nice_%d" % i for i in range(1, 5)]
+    + ["bench_erased"]
+)
+
+# Extra flags of the targets, must be kept in sync with the Makefile
+TARGET_FLAGS = {
+    "monster": ["-fno-rtti", "-O2"],
+    "bench_erased": ["-fno-rtti", "-O2"],
+}
+
+# Units compiled once per variant, with the flags of the variant
+VARIANTS = {
+    "bench_erased": [
+        ("inlined", ["-DBENCH_BOUNDARIES=1"]),
+        ("any_parser", ["-DBENCH_BOUNDARIES=2"]),
+        ("erased_parser", ["-DBENCH_BOUNDARIES=4"]),
+    ],
+}
+
+FIELDS = [
+    "compiler", "target", "unit", "status",
+    "wall_s", "peak_rss_kb", "object_bytes",
+    "instantiations", "instantiation_ms",
+]
+
+GNU_TIME = "/usr/bin/time"
+
+
+def units(target):
+    if target == "monster":
+        return sorted(glob.glob("src/monster/*.cpp"))
+    return ["src/%s.cpp" % target]
+
+
+def units_and_variants(target):
+    for source in units(target):
+        for variant, flags in VARIANTS.get(target, [("", [])]):
+            yield source, variant, flags
+
+
+def is_clang(compiler):
+    out = subprocess.run([compiler, "--version"], stdout=subprocess.PIPE,
+                         stderr=subprocess.DEVNULL, universal_newlines=True)
+    return "clang" in out.stdout
+
+
+def run(command):
+    """Run the command and return (success, wall seconds, peak RSS in KB)"""
+
+    if os.access(GNU_TIME, os.X_OK):
+        start = time.monotonic()
+        proc = subprocess.run([GNU_TIME, "-v"] + command,
+                              stdout=subprocess.DEVNULL, stderr=subprocess.PIPE,
+                              universal_newlines=True)
+        wall = time.monotonic() - start
+
+        rss = re.search(r"Maximum resident set size \(kbytes\): (\d+)", proc.stderr)
+        return proc.returncode == 0, wall, int(rss.group(1)) if rss else 0
+
+    # Without GNU time, wait4 gives the resource usage of this very child
+    start = time.monotonic()
+    proc = subprocess.Popen(command, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    _, status, usage = os.wait4(proc.pid, 0)
+    wall = time.monotonic() - start
+    proc.returncode = os.waitstatus_to_exitcode(status)
+
+    # ru_maxrss is already in kilobytes on Linux
+    return proc.returncode == 0, wall, usage.ru_maxrss
+
+
+def instantiations(trace_file):
+    """Count the template instantiations recorded in a -ftime-trace file"""
+
+    if not os.path.exists(trace_file):
+        return "", ""
+
+    with open(trace_file) as f:
+        events = json.load(f).get("traceEvents", [])
+
+    count = 0
+    duration = 0
+    for event in events:
+        if event.get("name") in ("InstantiateClass", "InstantiateFunction"):
+            count += 1
+            duration += event.get("dur", 0)
+
+    return count, "%.1f" % (duration / 1000.0)
+
+
+def bench(compiler, flags, build_dir, writer):
+    clang = is_clang(compiler)
+    name = os.path.basename(compiler)
+
+    for target in TARGETS:
+        for source, variant, variant_flags in units_and_variants(target):
+            unit = os.path.splitext(os.path.basename(source))[0]
+            if variant:
+                unit += "_" + variant
+
+            obj = os.path.join(build_dir, "%s_%s_%s.o" % (name, target, unit))
+            trace = os.path.splitext(obj)[0] + ".json"
+
+            for stale in (obj, trace):
+                if os.path.exists(stale):
+                    os.remove(stale)
+
+            command = [compiler] + TARGET_FLAGS.get(target, []) + variant_flags + flags
+            if clang:
+                command.append("-ftime-trace")
+            command += ["-o", obj, "-c", source]
+
+            ok, wall, rss = run(command)
+            count, duration = instantiations(trace) if clang else ("", "")
+
+            writer.writerow({
+                "compiler": name,
+                "target": target,
+                "unit": unit,
+                "status": "ok" if ok else "failed",
+                "wall_s": "%.2f" % wall,
+                "peak_rss_kb": rss,
+                "object_bytes": os.path.getsize(obj) if ok else "",
+                "instantiations": count,
+                "instantiation_ms": duration,
+            })
+
+            print("%-10s %-12s %-12s %-6s %7.2fs %8d KB" % (
+                name, target, unit, "ok" if ok else "failed", wall, rss))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compile-time benchmark of the grammars")
+    parser.add_argument("--compilers", default="clang++ g++",
+                        help="space separated list of compilers")
+    parser.add_argument("--flags", default="", help="flags passed to every compilation")
+    parser.add_argument("--build-dir", default="bench_compile")
+    parser.add_argument("--output", default="bench_compile.csv")
+    args = parser.parse_args()
+
+    compilers = [c for c in args.compilers.split() if shutil.which(c)]
+    if not compilers:
+        print("None of the compilers is available: %s" % args.compilers)
+        return 1
+
+    os.makedirs(args.build_dir, exist_ok=True)
+
+    with open(args.output, "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=FIELDS)
+        writer.writeheader()
+
+        for compiler in compilers:
+            bench(compiler, shlex.split(args.flags), args.build_dir, writer)
+
+    print("Results written to %s" % args.output)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,180 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Monotonic arena for the AST.
+ *
+ * While an arena_scope is alive, the containers and the nodes of the AST
+ * (x3_ast::vector and the nodes behind x3::forward_ast) of the current thread
+ * are allocated in its arena instead of the heap. Nothing is freed
+ * individually: the memory is only given back when the arena is
+ * released, so a tree allocated entirely in the arena can be dropped in O(1),
+ * without running its destructors.
+ *
+ * Without an arena_scope, everything is allocated on the heap as usual.
+ */
+
+namespace x3_ast {
+
+class arena {
+    public:
+        explicit arena(std::size_t chunk_size = 64 * 1024) : chunk_size(chunk_size) {}
+
+        arena(const arena&) = delete;
+        arena& operator=(const arena&) = delete;
+
+        ~arena(){
+            release();
+        }
+
+        void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)){
+            std::size_t offset = (used + alignment - 1) & ~(alignment - 1);
+
+            if(chunks.empty() || offset + size > capacity){
+                grow(size + alignment);
+                offset = 0;
+            }
+
+            used = offset + size;
+            allocated_bytes += size;
+
+            return chunks.back() + offset;
+        }
+
+        // Frees all the memory of the arena at once
+        void release(){
+            for(char* chunk : chunks){
+                ::operator delete(chunk);
+            }
+
+            chunks.clear();
+            used = capacity = 0;
+            allocated_bytes = 0;
+        }
+
+        std::size_t allocated() const {
+            return allocated_bytes;
+        }
+
+        static arena*& current(){
+            static thread_local arena* resource = nullptr;
+            return resource;
+        }
+
+        // Storage of the nodes, remembering where it comes from for their operator delete
+        static void* allocate_node(std::size_t size){
+            arena* resource = current();
+
+            void* base = resource ? resource->allocate(node_header + size) : ::operator new(node_header + size);
+            *static_cast<arena**>(base) = resource;
+
+            return static_cast<char*>(base) + node_header;
+        }
+
+        static void deallocate_node(void* node){
+            void* base = static_cast<char*>(node) - node_header;
+
+            if(!*static_cast<arena**>(base)){
+                ::operator delete(base);
+            }
+        }
+
+    private:
+        static const std::size_t node_header = alignof(std::max_align_t);
+
+        std::vector<char*> chunks;
+        std::size_t chunk_size;
+        std::size_t used = 0;
+        std::size_t capacity = 0;
+        std::size_t allocated_bytes = 0;
+
+        void grow(std::size_t size){
+            // The chunks are doubled up to 16 MB to keep their number low
+            capacity = size > chunk_size ? size : chunk_size;
+            chunks.push_back(static_cast<char*>(::operator new(capacity)));
+
+            if(chunk_size < 16 * 1024 * 1024){
+                chunk_size *= 2;
+            }
+        }
+};
+
+// Allocates in the arena of the current thread when the scope is created
+class arena_scope {
+    public:
+        explicit arena_scope(arena& resource) : previous(arena::current()) {
+            arena::current() = &resource;
+        }
+
+        arena_scope(const arena_scope&) = delete;
+        arena_scope& operator=(const arena_scope&) = delete;
+
+        ~arena_scope(){
+            arena::current() = previous;
+        }
+
+    private:
+        arena* previous;
+};
+
+/*
+ * Allocator bound to the current arena at construction (or to the heap
+ * without arena_scope). It propagates with the containers, so that moving and
+ * swapping the attributes never mixes the memory of two resources.
+ */
+template<typename T>
+struct arena_allocator {
+    typedef T value_type;
+
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    arena* resource;
+
+    arena_allocator() : resource(arena::current()) {}
+
+    template<typename U>
+    arena_allocator(const arena_allocator<U>& other) : resource(other.resource) {}
+
+    T* allocate(std::size_t n){
+        if(resource){
+            return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t){
+        if(!resource){
+            ::operator delete(p);
+        }
+    }
+
+    // A copy belongs to the resource of the copying code, not of the source
+    arena_allocator select_on_container_copy_construction() const {
+        return arena_allocator();
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs){
+    return lhs.resource == rhs.resource;
+}
+
+template<typename T, typename U>
+bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs){
+    return lhs.resource != rhs.resource;
+}
+
+template<typename T>
+using vector = std::vector<T, arena_allocator<T>>;
+
+} //end of x3_ast namespace
+
+#endif
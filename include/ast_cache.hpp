@@ -0,0 +1,322 @@
+#ifndef AST_CACHE_HPP
+#define AST_CACHE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/fusion/include/for_each.hpp>
+#include <boost/fusion/include/is_sequence.hpp>
+
+#include "monster.hpp"
+
+/*
+ * Binary serialization of the monster AST and on-disk cache of the ASTs.
+ *
+ * The AST is written in depth-first order with variable length integers: the
+ * index of the alternative of the variants, the size of the vectors, the
+ * offset and the size of the views into the source and the index of the
+ * symbols in a table of the names of the file, written before the tree.
+ *
+ * The entries of the cache are named after the hash of the source and the
+ * version of the grammar. Loading an entry checks its header, the hash of its
+ * data and the bounds of everything it reads, and points the views into the
+ * given source. The tree itself is rebuilt, its containers cannot be mapped.
+ */
+
+namespace x3_ast {
+
+// To be incremented with each change of the grammar or of the AST
+const std::uint32_t grammar_version = 2;
+
+std::uint64_t content_hash(const char* first, const char* last);
+
+// Serializes the AST parsed from [first, last), fails if a view is outside of it
+bool serialize(const char* first, const char* last, const source_file& ast, std::string& out);
+
+// Reads an AST serialized for [first, last), fails if data is not valid
+bool deserialize(const char* data, std::size_t size, const char* first, const char* last, source_file& ast);
+
+// deserialize() with the hash of [first, last) already computed
+bool read_entry(const char* data, std::size_t size, const char* first, const char* last, std::uint64_t hash, source_file& ast);
+
+class ast_cache {
+    public:
+        explicit ast_cache(std::string directory) : directory(std::move(directory)) {}
+
+        bool load(const char* first, const char* last, source_file& ast) const;
+
+        // Written to a temporary file and renamed, parallel stores of the same entry are safe
+        bool store(const char* first, const char* last, const source_file& ast) const;
+
+        // The path of the entry of a source of the given hash
+        std::string entry(std::uint64_t hash) const;
+
+    private:
+        std::string directory;
+};
+
+namespace cache_detail {
+
+struct writer {
+    std::string& out;
+    const char* first;
+    const char* last;
+
+    std::unordered_map<std::uint32_t, std::uint32_t> indexes;
+    std::vector<symbol> symbols;
+    bool valid = true;
+
+    typedef void result_type;
+
+    writer(std::string& out, const char* first, const char* last) : out(out), first(first), last(last) {}
+
+    void varint(std::uint64_t value){
+        while(value >= 0x80){
+            out += static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+
+        out += static_cast<char>(value);
+    }
+
+    template<typename T>
+    void operator()(const T& value){
+        write(value);
+    }
+
+    template<typename T>
+    typename std::enable_if<boost::fusion::traits::is_sequence<T>::value>::type write(const T& value){
+        boost::fusion::for_each(value, [this](const auto& member){ this->write(member); });
+    }
+
+    template<typename T, typename Allocator>
+    void write(const std::vector<T, Allocator>& values){
+        varint(values.size());
+
+        for(auto& value : values){
+            write(value);
+        }
+    }
+
+    template<typename T>
+    void write(const boost::optional<T>& value){
+        out += static_cast<char>(value ? 1 : 0);
+
+        if(value){
+            write(*value);
+        }
+    }
+
+    template<typename T>
+    void write(const x3::forward_ast<T>& value){
+        write(value.get());
+    }
+
+    template<typename... T>
+    void write(const x3::variant<T...>& value){
+        varint(value.get().which());
+        boost::apply_visitor(*this, value);
+    }
+
+    void write(const string_view& value){
+        if(value.empty()){
+            varint(0);
+            varint(0);
+        } else if(value.data() >= first && value.data() + value.size() <= last){
+            varint(value.data() - first);
+            varint(value.size());
+        } else {
+            valid = false;
+        }
+    }
+
+    void write(symbol value){
+        auto it = indexes.find(value.value());
+
+        if(it == indexes.end()){
+            it = indexes.emplace(value.value(), symbols.size()).first;
+            symbols.push_back(value);
+        }
+
+        varint(it->second);
+    }
+
+    void write(int value){
+        // zigzag, the small negative values stay small
+        varint((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(static_cast<std::int64_t>(value) >> 63));
+    }
+
+    void write(double value){
+        char bytes[sizeof(double)];
+        std::memcpy(bytes, &value, sizeof(double));
+        out.append(bytes, sizeof(double));
+    }
+
+    void write(bool value){
+        out += static_cast<char>(value);
+    }
+
+    void write(char value){
+        out += value;
+    }
+};
+
+struct reader {
+    const char* it;
+    const char* end;
+    const char* first;
+    const char* last;
+
+    std::vector<symbol> symbols;
+    bool valid = true;
+
+    reader(const char* it, const char* end, const char* first, const char* last) : it(it), end(end), first(first), last(last) {}
+
+    std::uint64_t varint(){
+        std::uint64_t value = 0;
+
+        for(unsigned shift = 0; shift < 64; shift += 7){
+            if(it == end){
+                valid = false;
+                return 0;
+            }
+
+            unsigned char byte = *it++;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+
+            if(!(byte & 0x80)){
+                return value;
+            }
+        }
+
+        valid = false;
+        return 0;
+    }
+
+    char byte(){
+        if(it == end){
+            valid = false;
+            return 0;
+        }
+
+        return *it++;
+    }
+
+    template<typename T>
+    typename std::enable_if<boost::fusion::traits::is_sequence<T>::value>::type read(T& value){
+        boost::fusion::for_each(value, [this](auto& member){ this->read(member); });
+    }
+
+    template<typename T, typename Allocator>
+    void read(std::vector<T, Allocator>& values){
+        std::uint64_t size = varint();
+
+        // Each element takes at least one byte
+        if(size > static_cast<std::uint64_t>(end - it)){
+            valid = false;
+            return;
+        }
+
+        values.resize(size);
+
+        for(auto& value : values){
+            if(!valid){
+                return;
+            }
+
+            read(value);
+        }
+    }
+
+    template<typename T>
+    void read(boost::optional<T>& value){
+        if(byte()){
+            value = T();
+            read(*value);
+        }
+    }
+
+    template<typename T>
+    void read(x3::forward_ast<T>& value){
+        read(value.get());
+    }
+
+    template<typename... T>
+    void read(x3::variant<T...>& value){
+        read_alternative<0, x3::variant<T...>, T...>(varint(), value);
+    }
+
+    template<std::size_t I, typename Variant>
+    void read_alternative(std::uint64_t, Variant&){
+        valid = false;
+    }
+
+    template<std::size_t I, typename Variant, typename Head, typename... Tail>
+    void read_alternative(std::uint64_t which, Variant& variant){
+        if(which != I){
+            read_alternative<I + 1, Variant, Tail...>(which, variant);
+            return;
+        }
+
+        Head value;
+        read(value);
+        variant = std::move(value);
+    }
+
+    // The pointer fix-up of the views, from offsets to pointers into the source
+    void read(string_view& value){
+        std::uint64_t offset = varint();
+        std::uint64_t size = varint();
+
+        if(size == 0){
+            value = string_view();
+        } else if(offset <= static_cast<std::uint64_t>(last - first) && size <= static_cast<std::uint64_t>(last - first) - offset){
+            value = string_view(first + offset, size);
+        } else {
+            valid = false;
+        }
+    }
+
+    void read(symbol& value){
+        std::uint64_t index = varint();
+
+        if(index < symbols.size()){
+            value = symbols[index];
+        } else {
+            valid = false;
+        }
+    }
+
+    void read(int& value){
+        std::uint64_t zigzag = varint();
+        value = static_cast<int>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+    }
+
+    void read(double& value){
+        if(end - it < static_cast<std::ptrdiff_t>(sizeof(double))){
+            valid = false;
+            return;
+        }
+
+        std::memcpy(&value, it, sizeof(double));
+        it += sizeof(double);
+    }
+
+    void read(bool& value){
+        value = byte() != 0;
+    }
+
+    void read(char& value){
+        value = byte();
+    }
+};
+
+} // end of cache_detail namespace
+
+} //end of x3_ast namespace
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef BRACE_SCANNER_HPP
+#define BRACE_SCANNER_HPP
+
+#include <algorithm>
+
+#include "skipper.hpp"
+
+/*
+ * Finds the braces and the semicolons of eddic source without parsing it. The
+ * comments, the strings and the chars are skipped like the skipper and the
+ * grammar do, so that their braces are not counted.
+ */
+
+namespace x3_grammar {
+
+// Calls delimiter(it) for each '{', '}' or ';' of [first, last), stops if it returns false.
+// Returns false if [first, last) ends in an unterminated comment or string.
+template<typename Delimiter>
+bool scan_delimiters(const char* first, const char* last, Delimiter delimiter){
+    using namespace skipper_detail;
+
+    const char* it = first;
+    while(it != last){
+        char c = *it;
+
+        if(c == '/' && last - it >= 2 && it[1] == '/'){
+            it = find_line_end(it + 2, last);
+            continue;
+        } else if(c == '/' && last - it >= 2 && it[1] == '*'){
+            it += 2;
+
+            if(!find_comment_end(it, last)){
+                return false;
+            }
+
+            continue;
+        } else if(c == '"'){
+            it = std::find(it + 1, last, '"');
+
+            if(it == last){
+                return false;
+            }
+        } else if(c == '\'' && last - it >= 3 && it[2] == '\''){
+            it += 2;
+        } else if((c == '{' || c == '}' || c == ';') && !delimiter(it)){
+            return true;
+        }
+
+        ++it;
+    }
+
+    return true;
+}
+
+// Calls brace(it) for each '{' or '}' of [first, last), stops if it returns false
+template<typename Brace>
+void scan_braces(const char* first, const char* last, Brace brace){
+    scan_delimiters(first, last, [&](const char* it){
+        return *it == ';' || brace(it);
+    });
+}
+
+// The number of '{' minus the number of '}'
+inline long brace_balance(const char* first, const char* last){
+    long balance = 0;
+
+    scan_braces(first, last, [&](const char* brace){
+        balance += *brace == '{' ? 1 : -1;
+        return true;
+    });
+
+    return balance;
+}
+
+// Whether [first, last) ends inside a comment or a string
+inline bool unterminated(const char* first, const char* last){
+    return !scan_delimiters(first, last, [](const char*){ return true; });
+}
+
+} // end of grammar namespace
+
+#endif
@@ -0,0 +1,387 @@
+#ifndef EDDIC_GENERATOR_HPP
+#define EDDIC_GENERATOR_HPP
+
+#include <initializer_list>
+#include <map>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * Deterministic generator of valid eddic sources for the monster grammar.
+ *
+ * The output only depends on the options, the same seed always produces the
+ * same source. std::mt19937 is fully specified by the standard, the
+ * distributions are not, that is why the numbers are drawn directly from the
+ * engine.
+ */
+
+struct generator_options {
+    unsigned long seed = 42;
+
+    std::size_t size = 1024 * 1024;     // Minimum size of the generated source
+    std::size_t depth = 4;              // Maximum nesting of the instruction blocks
+    std::size_t type_depth = 2;         // Maximum nesting of the template types
+    std::size_t function_size = 24;     // Maximum number of instructions in a function
+
+    // Relative weight of each construct
+    std::map<std::string, unsigned> mix = {
+        // Top-level blocks
+        {"struct", 2},
+        {"function", 6},
+        {"global", 1},
+        {"global_array", 1},
+
+        // Instructions
+        {"if", 3},
+        {"foreach", 2},
+        {"foreach_in", 2},
+        {"while", 2},
+        {"do_while", 1},
+        {"return", 2},
+        {"delete", 1},
+        {"declaration", 8},
+        {"struct_declaration", 2},
+        {"array_declaration", 2},
+
+        // Percentage of templated structs and functions
+        {"template", 30},
+
+        // Percentage of blocks and instructions preceded by a comment
+        {"comment", 10},
+    };
+};
+
+class eddic_generator {
+    public:
+        explicit eddic_generator(const generator_options& options) : options(options), engine(options.seed) {}
+
+        // Write blocks until at least options.size bytes have been written
+        std::size_t generate(std::ostream& out){
+            std::size_t written = 0;
+
+            std::string header = "import <std>\nimport \"utils\"\n\n";
+            out << header;
+            written += header.size();
+
+            while(written < options.size){
+                std::string next = block();
+                out << next;
+                written += next.size();
+            }
+
+            return written;
+        }
+
+        // The same source as a string
+        std::string generate(){
+            std::ostringstream out;
+            generate(out);
+            return out.str();
+        }
+
+        // Generate the next top-level block
+        std::string block(){
+            std::string out;
+
+            comment(out, "");
+
+            auto kind = pick({"struct", "function", "global", "global_array"});
+
+            if(kind == "struct"){
+                template_struct(out);
+            } else if(kind == "function"){
+                function(out, "");
+            } else if(kind == "global"){
+                out += concat({type(), " ", name("global_"), " = ", value(), ";\n"});
+            } else {
+                out += concat({type(), " ", name("table_"), "[", integer(), "];\n"});
+            }
+
+            out += "\n";
+            return out;
+        }
+
+    private:
+        const generator_options options;
+        std::mt19937 engine;
+        std::size_t counter = 0;
+
+        // The elements of a braced list are evaluated in order, the operands of + are not
+        static std::string concat(std::initializer_list<std::string> parts){
+            std::string result;
+
+            for(auto& part : parts){
+                result += part;
+            }
+
+            return result;
+        }
+
+        std::size_t uniform(std::size_t n){
+            return engine() % n;
+        }
+
+        bool percent(const std::string& construct){
+            return uniform(100) < weight(construct);
+        }
+
+        unsigned weight(const std::string& construct) const {
+            auto it = options.mix.find(construct);
+            return it == options.mix.end() ? 0 : it->second;
+        }
+
+        std::string pick(const std::vector<std::string>& constructs){
+            unsigned total = 0;
+            for(auto& construct : constructs){
+                total += weight(construct);
+            }
+
+            // Everything has been disabled, fall back to the last one
+            if(!total){
+                return constructs.back();
+            }
+
+            unsigned n = uniform(total);
+            for(auto& construct : constructs){
+                if(n < weight(construct)){
+                    return construct;
+                }
+
+                n -= weight(construct);
+            }
+
+            return constructs.back();
+        }
+
+        template<std::size_t N>
+        std::string pick_name(const char* const (&names)[N]){
+            return names[uniform(N)];
+        }
+
+        // None of the names starts with a keyword that could be taken as an instruction
+        std::string name(const std::string& prefix = ""){
+            static const char* const names[] = {"a", "b", "count", "value", "index", "total", "buffer", "left", "right", "node", "item", "key", "size", "x", "y", "first", "last"};
+            return prefix + pick_name(names) + (prefix.empty() ? "" : std::to_string(counter++));
+        }
+
+        std::string type_name(){
+            static const char* const names[] = {"int", "float", "string", "char", "bool", "long", "Point", "Node", "Entry", "T", "U"};
+            return pick_name(names);
+        }
+
+        std::string template_name(){
+            static const char* const names[] = {"vector", "map", "list", "set", "pair", "Box"};
+            return pick_name(names);
+        }
+
+        std::string integer(){
+            return std::to_string(1 + uniform(64));
+        }
+
+        std::string value(){
+            switch(uniform(6)){
+                case 0:
+                    return name();
+                case 1:
+                    return integer() + "L";
+                case 2:
+                    return concat({std::to_string(uniform(100)), ".", std::to_string(uniform(100))});
+                case 3:
+                    return integer();
+                case 4:
+                    return concat({"\"", name(), " ", name(), "\""});
+                default:
+                    return std::string("'") + static_cast<char>('a' + uniform(26)) + "'";
+            }
+        }
+
+        // The grammar only allows one level of array or pointer on a template or simple type
+        std::string type(std::size_t depth = 0){
+            std::string base;
+
+            if(depth < options.type_depth && uniform(3) == 0){
+                base = concat({template_name(), "<", type(depth + 1)});
+
+                for(std::size_t i = uniform(2); i > 0; --i){
+                    base += ", " + type(depth + 1);
+                }
+
+                base += ">";
+            } else {
+                if(uniform(8) == 0){
+                    base = "const ";
+                }
+
+                base += type_name();
+            }
+
+            switch(uniform(6)){
+                case 0:
+                    return base + "[]";
+                case 1:
+                    return base + "*";
+                default:
+                    return base;
+            }
+        }
+
+        void indent(std::string& out, std::size_t depth){
+            out.append(4 * depth, ' ');
+        }
+
+        void comment(std::string& out, const std::string& indentation){
+            if(percent("comment")){
+                if(uniform(2)){
+                    out += concat({indentation, "// ", name(), " ", name(), "\n"});
+                } else {
+                    out += concat({indentation, "/* ", name(), "\n", indentation, "   ", name(), " */\n"});
+                }
+            }
+        }
+
+        std::string template_declaration(){
+            std::string out = "template<type T";
+
+            if(uniform(2)){
+                out += ", type U";
+            }
+
+            return out + ">\n";
+        }
+
+        void template_struct(std::string& out){
+            if(percent("template")){
+                out += template_declaration();
+            }
+
+            out += "struct " + name("Struct");
+
+            if(uniform(4) == 0){
+                out += " extends " + type();
+            }
+
+            out += " {\n";
+
+            for(std::size_t i = 1 + uniform(5); i > 0; --i){
+                switch(uniform(4)){
+                    case 0:
+                        out += concat({"    ", type(), " ", name(), "[", integer(), "];\n"});
+                        break;
+                    case 1:
+                        function(out, "    ");
+                        break;
+                    default:
+                        out += concat({"    ", type(), " ", name(), ";\n"});
+                        break;
+                }
+            }
+
+            out += "}\n";
+        }
+
+        void function(std::string& out, const std::string& indentation){
+            if(percent("template")){
+                out += indentation + template_declaration();
+            }
+
+            out += concat({indentation, type(), " ", name("function_"), "("});
+
+            for(std::size_t i = 0, n = uniform(4); i < n; ++i){
+                out += concat({i ? ", " : "", type(), " ", name()});
+            }
+
+            out += "){\n";
+
+            std::size_t budget = 1 + uniform(options.function_size);
+            instructions(out, budget, 1, indentation.size() / 4 + 1);
+
+            out += indentation + "}\n";
+        }
+
+        void instructions(std::string& out, std::size_t& budget, std::size_t depth, std::size_t level){
+            for(std::size_t i = 1 + uniform(4); i > 0 && budget > 0; --i){
+                instruction(out, budget, depth, level);
+            }
+        }
+
+        void body(std::string& out, std::size_t& budget, std::size_t depth, std::size_t level){
+            out += "{\n";
+            instructions(out, budget, depth + 1, level + 1);
+            indent(out, level);
+            out += "}";
+        }
+
+        void instruction(std::string& out, std::size_t& budget, std::size_t depth, std::size_t level){
+            --budget;
+
+            comment(out, std::string(4 * level, ' '));
+            indent(out, level);
+
+            std::string kind;
+            if(depth < options.depth){
+                kind = pick({"if", "foreach", "foreach_in", "while", "do_while", "return", "delete", "struct_declaration", "array_declaration", "declaration"});
+            } else {
+                kind = pick({"return", "delete", "struct_declaration", "array_declaration", "declaration"});
+            }
+
+            if(kind == "if"){
+                out += "if(" + value() + ")";
+                body(out, budget, depth, level);
+
+                for(std::size_t i = uniform(3); i > 0; --i){
+                    out += " else if(" + value() + ")";
+                    body(out, budget, depth, level);
+                }
+
+                if(uniform(2)){
+                    out += " else ";
+                    body(out, budget, depth, level);
+                }
+
+                out += "\n";
+            } else if(kind == "foreach"){
+                out += concat({"foreach(", type(), " ", name(), " from ", std::to_string(uniform(10)), " to ", integer(), ")"});
+                body(out, budget, depth, level);
+                out += "\n";
+            } else if(kind == "foreach_in"){
+                out += concat({"foreach(", type(), " ", name(), " in ", name(), ")"});
+                body(out, budget, depth, level);
+                out += "\n";
+            } else if(kind == "while"){
+                out += "while(" + value() + ")";
+                body(out, budget, depth, level);
+                out += "\n";
+            } else if(kind == "do_while"){
+                out += "do ";
+                body(out, budget, depth, level);
+                out += " while(" + value() + ");\n";
+            } else if(kind == "return"){
+                out += "return " + value() + ";\n";
+            } else if(kind == "delete"){
+                out += "delete " + name() + ";\n";
+            } else if(kind == "struct_declaration"){
+                out += concat({type(), " ", name(), "("});
+
+                for(std::size_t i = 0, n = uniform(4); i < n; ++i){
+                    out += (i ? ", " : "") + value();
+                }
+
+                out += ");\n";
+            } else if(kind == "array_declaration"){
+                out += concat({type(), " ", name(), "[", value(), "];\n"});
+            } else {
+                out += concat({type(), " ", name()});
+
+                if(uniform(3)){
+                    out += " = " + value();
+                }
+
+                out += ";\n";
+            }
+        }
+};
+
+#endif
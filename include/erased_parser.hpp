@@ -0,0 +1,181 @@
+#ifndef ERASED_PARSER_HPP
+#define ERASED_PARSER_HPP
+
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <boost/spirit/home/x3.hpp>
+
+namespace x3 = boost::spirit::x3;
+
+/*
+ * Type erasure of a parser, for a fixed iterator, attribute and context.
+ *
+ * Like x3::any_parser, erased_parser<Iterator, Attribute, Context> hides the
+ * type of a parser so that the grammars using it do not instantiate it. But
+ * the parser is stored in the erased_parser itself instead of on the heap (a
+ * parser larger than Capacity bytes does not compile, a rule or a small
+ * expression fits), and a parse is a single call through a function pointer
+ * instantiated for Context, instead of a virtual call. A default constructed
+ * erased_parser always fails.
+ *
+ * The context of the caller must be convertible to Context: with the default
+ * x3::subcontext<> the skipper is not passed (use x3::skip inside), with
+ * x3_grammar::context_type it is. The attribute is parsed in place when it is
+ * Attribute, otherwise it is parsed in an Attribute and moved.
+ */
+
+namespace x3_grammar {
+
+template<typename Iterator, typename Attribute = x3::unused_type, typename Context = x3::subcontext<>, std::size_t Capacity = 4 * sizeof(void*)>
+class erased_parser : public x3::parser<erased_parser<Iterator, Attribute, Context, Capacity>> {
+    public:
+        typedef Attribute attribute_type;
+
+        static bool const has_attribute = !std::is_same<x3::unused_type, Attribute>::value;
+        static bool const handles_container = x3::traits::is_container<Attribute>::value;
+
+        erased_parser() = default;
+
+        template<typename Expr, typename Enable = typename std::enable_if<x3::traits::is_parser<Expr>::value>::type>
+        erased_parser(Expr const& expr){
+            typedef typename x3::extension::as_parser<Expr>::value_type parser_type;
+            typedef inline_holder<parser_type> holder_type;
+
+            static_assert(fits<parser_type>::value, "The parser does not fit in the Capacity of the erased_parser");
+
+            holder_type::create(&storage, x3::as_parser(expr));
+
+            invoke = &holder_type::parse;
+            table = &holder_type::operations();
+        }
+
+        erased_parser(const erased_parser& other){
+            assign(other);
+        }
+
+        erased_parser& operator=(const erased_parser& other){
+            if(this != &other){
+                reset();
+                assign(other);
+            }
+
+            return *this;
+        }
+
+        ~erased_parser(){
+            reset();
+        }
+
+        template<typename RContext>
+        bool parse(Iterator& first, Iterator const& last, Context const& context, RContext&, Attribute& attr) const {
+            return invoke(&storage, first, last, context, attr);
+        }
+
+        template<typename RContext, typename ActualAttribute>
+        bool parse(Iterator& first, Iterator const& last, Context const& context, RContext& rcontext, ActualAttribute& actual) const {
+            Attribute attr;
+
+            if(parse(first, last, context, rcontext, attr)){
+                x3::traits::move_to(attr, actual);
+                return true;
+            }
+
+            return false;
+        }
+
+        std::string get_info() const {
+            return table ? table->info(&storage) : "";
+        }
+
+    private:
+        typedef typename std::aligned_storage<Capacity, alignof(void*)>::type storage_type;
+
+        typedef bool (*parse_function)(const void*, Iterator&, Iterator const&, Context const&, Attribute&);
+
+        struct operations_table {
+            void (*copy)(const void*, void*);
+            void (*destroy)(void*);
+            std::string (*info)(const void*);
+        };
+
+        static bool fail(const void*, Iterator&, Iterator const&, Context const&, Attribute&){
+            return false;
+        }
+
+        template<typename Parser>
+        struct fits : std::integral_constant<bool, sizeof(Parser) <= sizeof(storage_type) && alignof(Parser) <= alignof(storage_type)> {};
+
+        template<typename Parser>
+        struct inline_holder {
+            static const Parser& get(const void* storage){
+                return *static_cast<const Parser*>(storage);
+            }
+
+            static void create(void* storage, const Parser& parser){
+                new (storage) Parser(parser);
+            }
+
+            static void copy(const void* from, void* to){
+                create(to, get(from));
+            }
+
+            static void destroy(void* storage){
+                static_cast<Parser*>(storage)->~Parser();
+            }
+
+            static bool parse(const void* storage, Iterator& first, Iterator const& last, Context const& context, Attribute& attr){
+                return get(storage).parse(first, last, context, x3::unused, attr);
+            }
+
+            static std::string info(const void* storage){
+                return x3::what(get(storage));
+            }
+
+            static const operations_table& operations(){
+                static const operations_table table = {&copy, &destroy, &info};
+                return table;
+            }
+        };
+
+        storage_type storage;
+        parse_function invoke = &fail;
+        const operations_table* table = nullptr;
+
+        void assign(const erased_parser& other){
+            if(other.table){
+                other.table->copy(&other.storage, &storage);
+            }
+
+            invoke = other.invoke;
+            table = other.table;
+        }
+
+        void reset(){
+            if(table){
+                table->destroy(&storage);
+            }
+
+            invoke = &fail;
+            table = nullptr;
+        }
+};
+
+} // end of grammar namespace
+
+namespace boost { namespace spirit { namespace x3 {
+
+template<typename Iterator, typename Attribute, typename Context, std::size_t Capacity>
+struct get_info<x3_grammar::erased_parser<Iterator, Attribute, Context, Capacity>> {
+    typedef std::string result_type;
+
+    std::string operator()(x3_grammar::erased_parser<Iterator, Attribute, Context, Capacity> const& p) const {
+        return p.get_info();
+    }
+};
+
+}}}
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef EXPECT_HPP
+#define EXPECT_HPP
+
+#include <string>
+#include <utility>
+
+#include <boost/spirit/home/x3.hpp>
+
+namespace x3 = boost::spirit::x3;
+
+/*
+ * Expectation points of the monster grammar.
+ *
+ * The grammar writes a > b as a >> expect[b]. By default, expect is x3::expect
+ * and a failed expectation throws an x3::expectation_failure. Built with
+ * MONSTER_NO_EXCEPTIONS (make monster_noexcept), expect[b] records the failure
+ * in the expectation state of the current thread and fails instead, and the
+ * rules defined with MONSTER_DEFINE fail as soon as the state holds a failure,
+ * so the parse returns to its caller without trying the other alternatives.
+ *
+ * catch_expectation(failure, parse) runs the parse and gives the first failed
+ * expectation in failure in both modes, fail_expectation(failure) reports it
+ * again to the enclosing parse (throws or sets the state back).
+ */
+
+namespace x3_grammar {
+
+template<typename Iterator>
+struct expectation_error {
+    bool failed = false;
+    Iterator where;
+    std::string which;
+
+    explicit operator bool() const {
+        return failed;
+    }
+};
+
+#ifndef MONSTER_NO_EXCEPTIONS
+
+using x3::expect;
+
+template<typename Iterator, typename Parse>
+bool catch_expectation(expectation_error<Iterator>& error, Parse&& parse){
+    try {
+        return parse();
+    } catch(const x3::expectation_failure<Iterator>& e){
+        error.failed = true;
+        error.where = e.where();
+        error.which = e.which();
+        return false;
+    }
+}
+
+template<typename Iterator>
+bool fail_expectation(expectation_error<Iterator>& error){
+    boost::throw_exception(x3::expectation_failure<Iterator>(error.where, error.which));
+}
+
+template<typename Definition, typename Iterator, typename Context, typename Attribute>
+bool parse_definition(Definition const& definition, Iterator& first, Iterator const& last, Context const& context, Attribute& attr){
+    return definition.parse(first, last, context, x3::unused, attr);
+}
+
+#else
+
+template<typename Iterator>
+expectation_error<Iterator>& expectation_state(){
+    static thread_local expectation_error<Iterator> state;
+    return state;
+}
+
+// Only the first failure is kept, as the first exception would have aborted the parse
+template<typename Iterator>
+bool fail_expectation(expectation_error<Iterator>& error){
+    auto& state = expectation_state<Iterator>();
+
+    if(!state.failed){
+        state = std::move(error);
+    }
+
+    return false;
+}
+
+template<typename Iterator, typename Parse>
+bool catch_expectation(expectation_error<Iterator>& error, Parse&& parse){
+    auto& state = expectation_state<Iterator>();
+
+    bool result = parse();
+
+    if(state.failed){
+        error = std::move(state);
+        state.failed = false;
+        return false;
+    }
+
+    return result;
+}
+
+template<typename Subject>
+struct expect_directive : x3::unary_parser<Subject, expect_directive<Subject>> {
+    typedef x3::unary_parser<Subject, expect_directive<Subject>> base_type;
+    static bool const is_pass_through_unary = true;
+
+    constexpr expect_directive(Subject const& subject) : base_type(subject) {}
+
+    template<typename Iterator, typename Context, typename RContext, typename Attribute>
+    bool parse(Iterator& first, Iterator const& last, Context const& context, RContext& rcontext, Attribute& attr) const {
+        if(expectation_state<Iterator>().failed){
+            return false;
+        }
+
+        if(this->subject.parse(first, last, context, rcontext, attr)){
+            return true;
+        }
+
+        expectation_error<Iterator> error;
+        error.failed = true;
+        error.where = first;
+        error.which = x3::what(this->subject);
+        return fail_expectation(error);
+    }
+};
+
+struct expect_gen {
+    template<typename Subject>
+    constexpr expect_directive<typename x3::extension::as_parser<Subject>::value_type> operator[](Subject const& subject) const {
+        return {x3::as_parser(subject)};
+    }
+};
+
+constexpr auto expect = expect_gen{};
+
+// The parse of a rule definition, which fails once an expectation failed
+template<typename Definition, typename Iterator, typename Context, typename Attribute>
+bool parse_definition(Definition const& definition, Iterator& first, Iterator const& last, Context const& context, Attribute& attr){
+    auto& state = expectation_state<Iterator>();
+
+    return !state.failed && definition.parse(first, last, context, x3::unused, attr) && !state.failed;
+}
+
+#endif
+
+} // end of grammar namespace
+
+#ifdef MONSTER_NO_EXCEPTIONS
+
+namespace boost { namespace spirit { namespace x3 { namespace detail {
+
+// As for x3::expect, the containers are parsed into directly
+template<typename Subject, typename Context, typename RContext>
+struct parse_into_container_impl<x3_grammar::expect_directive<Subject>, Context, RContext> {
+    template<typename Iterator, typename Attribute>
+    static bool call(x3_grammar::expect_directive<Subject> const& parser, Iterator& first, Iterator const& last, Context const& context, RContext& rcontext, Attribute& attr){
+        if(x3_grammar::expectation_state<Iterator>().failed){
+            return false;
+        }
+
+        if(parse_into_container(parser.subject, first, last, context, rcontext, attr)){
+            return true;
+        }
+
+        x3_grammar::expectation_error<Iterator> error;
+        error.failed = true;
+        error.where = first;
+        error.which = what(parser.subject);
+        return x3_grammar::fail_expectation(error);
+    }
+};
+
+}}}}
+
+#endif
+
+#endif
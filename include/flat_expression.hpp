@@ -0,0 +1,282 @@
+#ifndef FLAT_EXPRESSION_HPP
+#define FLAT_EXPRESSION_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <boost/spirit/home/x3.hpp>
+#include <boost/spirit/home/x3/support/ast/variant.hpp>
+
+namespace x3 = boost::spirit::x3;
+
+/*
+ * Flattened expressions.
+ *
+ * A flat_expression<Leaf, Operator> holds a whole expression tree in a few
+ * contiguous arrays, the nodes referring to each other with 32-bit indices
+ * instead of forward_ast pointers. Each array holds one field (struct of
+ * arrays): a node is a kind and the index of its leaf or of its expression,
+ * an expression is its first node and the range of its operations, and the
+ * operators and the operand nodes of the operations are in two arrays. The
+ * operations of an expression are contiguous and the children are stored
+ * before their parents, the root is the last node.
+ *
+ * flatten(value) builds it from a tree (a variant of Leaf and
+ * forward_ast<Expression>, with first and operations). clear() keeps the
+ * memory of the arrays, to reuse the same pool for the next expression.
+ *
+ * The nodes are walked with value_ref, expression_ref and operation_ref, which
+ * have the members of the tree (first, operations, op, value and get()), and
+ * apply_visitor(visitor, value_ref), found by ADL, so that a visitor written
+ * for the tree (with a template for the expression and using
+ * boost::apply_visitor unqualified) walks both.
+ */
+
+namespace x3_ast {
+
+template<typename Leaf, typename Operator>
+class flat_expression {
+    public:
+        typedef std::uint32_t index;
+
+        enum class kind : std::uint8_t {
+            leaf,
+            expression
+        };
+
+        class value_ref;
+        class expression_ref;
+
+        struct operation_ref {
+            Operator op;
+            value_ref value;
+        };
+
+        class operation_iterator {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef operation_ref value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef const operation_ref* pointer;
+                typedef operation_ref reference;
+
+                operation_iterator(const flat_expression* tree, index operation) : tree(tree), operation(operation) {}
+
+                operation_ref operator*() const {
+                    return {tree->operators[operation], value_ref(tree, tree->operands[operation])};
+                }
+
+                operation_iterator& operator++(){
+                    ++operation;
+                    return *this;
+                }
+
+                bool operator==(const operation_iterator& rhs) const {
+                    return operation == rhs.operation;
+                }
+
+                bool operator!=(const operation_iterator& rhs) const {
+                    return operation != rhs.operation;
+                }
+
+            private:
+                const flat_expression* tree;
+                index operation;
+        };
+
+        struct operation_range {
+            operation_iterator first;
+            operation_iterator last;
+
+            operation_iterator begin() const {
+                return first;
+            }
+
+            operation_iterator end() const {
+                return last;
+            }
+
+            std::size_t size() const {
+                return std::distance(first, last);
+            }
+        };
+
+        class value_ref {
+            public:
+                value_ref(const flat_expression* tree, index node) : tree(tree), node(node) {}
+
+                bool is_leaf() const {
+                    return tree->kinds[node] == kind::leaf;
+                }
+
+                const Leaf& leaf() const {
+                    return tree->leaves[tree->items[node]];
+                }
+
+                expression_ref expression() const {
+                    return expression_ref(tree, tree->items[node]);
+                }
+
+                // Calls the visitor with the leaf or with the expression_ref
+                template<typename Visitor>
+                friend auto apply_visitor(Visitor& visitor, const value_ref& value) -> decltype(visitor(value.leaf())) {
+                    return value.is_leaf() ? visitor(value.leaf()) : visitor(value.expression());
+                }
+
+                template<typename Visitor>
+                friend auto apply_visitor(const Visitor& visitor, const value_ref& value) -> decltype(visitor(value.leaf())) {
+                    return value.is_leaf() ? visitor(value.leaf()) : visitor(value.expression());
+                }
+
+            private:
+                const flat_expression* tree;
+                index node;
+        };
+
+        class expression_ref {
+            public:
+                value_ref first;
+                operation_range operations;
+
+                expression_ref(const flat_expression* tree, index expression)
+                    : first(tree, tree->firsts[expression])
+                    , operations{{tree, tree->begins[expression]}, {tree, tree->begins[expression] + tree->sizes[expression]}} {}
+
+                // As forward_ast<Expression>
+                const expression_ref& get() const {
+                    return *this;
+                }
+        };
+
+        void clear(){
+            kinds.clear();
+            items.clear();
+            leaves.clear();
+            firsts.clear();
+            begins.clear();
+            sizes.clear();
+            operators.clear();
+            operands.clear();
+        }
+
+        bool empty() const {
+            return kinds.empty();
+        }
+
+        std::size_t nodes() const {
+            return kinds.size();
+        }
+
+        std::size_t expressions() const {
+            return firsts.size();
+        }
+
+        // The last node added, the expression must not be empty
+        value_ref root() const {
+            assert(!empty());
+            return value_ref(this, kinds.size() - 1);
+        }
+
+        index add_leaf(Leaf leaf){
+            leaves.push_back(std::move(leaf));
+            return add_node(kind::leaf, leaves.size() - 1);
+        }
+
+        // The operations are pairs of an operator and a node
+        template<typename Iterator>
+        index add_expression(index first, Iterator begin, Iterator end){
+            firsts.push_back(first);
+            begins.push_back(operators.size());
+
+            for(; begin != end; ++begin){
+                operators.push_back(begin->first);
+                operands.push_back(begin->second);
+            }
+
+            sizes.push_back(operators.size() - begins.back());
+
+            return add_node(kind::expression, firsts.size() - 1);
+        }
+
+        template<typename Value>
+        void flatten(const Value& value){
+            clear();
+
+            builder{*this}.add(value);
+        }
+
+    private:
+        // The nodes
+        std::vector<kind> kinds;
+        std::vector<index> items;
+
+        std::vector<Leaf> leaves;
+
+        // The expressions
+        std::vector<index> firsts;
+        std::vector<index> begins;
+        std::vector<index> sizes;
+
+        // The operations
+        std::vector<Operator> operators;
+        std::vector<index> operands;
+
+        // The operations of the expressions being flattened, the deepest last
+        std::vector<std::pair<Operator, index>> pending;
+
+        index add_node(kind node_kind, index item){
+            kinds.push_back(node_kind);
+            items.push_back(item);
+            return kinds.size() - 1;
+        }
+
+        // Adds the nodes of a tree, the children before their parent
+        struct builder {
+            flat_expression& tree;
+
+            typedef index result_type;
+
+            index add(const Leaf& leaf){
+                return tree.add_leaf(leaf);
+            }
+
+            template<typename Expression>
+            index add(const Expression& expression){
+                index first = add(expression.first);
+
+                auto& pending = tree.pending;
+                std::size_t mark = pending.size();
+
+                for(auto& operation : expression.operations){
+                    index operand = add(operation.value);
+                    pending.emplace_back(operation.op, operand);
+                }
+
+                index node = tree.add_expression(first, pending.begin() + mark, pending.end());
+                pending.resize(mark);
+                return node;
+            }
+
+            template<typename Expression>
+            index add(const x3::forward_ast<Expression>& expression){
+                return add(expression.get());
+            }
+
+            template<typename... T>
+            index add(const x3::variant<T...>& value){
+                return boost::apply_visitor(*this, value);
+            }
+
+            template<typename T>
+            index operator()(const T& value){
+                return add(value);
+            }
+        };
+};
+
+} // end of x3_ast namespace
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef INCREMENTAL_HPP
+#define INCREMENTAL_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "monster.hpp"
+
+/*
+ * Incremental parsing of a source being edited.
+ *
+ * The text is kept as a list of segments, one per top-level block (with the
+ * spaces and comments following it). An edit only parses again the segments
+ * it touches, extended to the next ones while it has unclosed braces (to the
+ * end with an unclosed comment or string) and to the text that failed to
+ * parse before, and splices the new blocks in the AST.
+ *
+ * The views of the AST point into the buffers of the segments, the buffer of
+ * the first parse is kept as long as a segment uses it. The AST is allocated
+ * on the heap, an arena would grow with each edit.
+ */
+class incremental_source {
+    public:
+        // Parses the whole text, returns false if it is invalid
+        bool parse(std::string text);
+
+        // Replaces length characters at offset with replacement and parses the affected blocks again
+        bool edit(std::size_t offset, std::size_t length, const std::string& replacement);
+
+        // Valid only if the last parse or edit succeeded
+        const x3_ast::source_file& ast() const {
+            return result;
+        }
+
+        bool valid() const {
+            return error_message.empty();
+        }
+
+        // line:column: error of the text that failed to parse
+        std::string error() const;
+
+        std::string text() const;
+
+        std::size_t size() const {
+            return length;
+        }
+
+        // The offset of each top-level block (including its leading spaces)
+        std::vector<std::size_t> block_offsets() const;
+
+        // Number of characters parsed by the last parse or edit
+        std::size_t parsed() const {
+            return parsed_size;
+        }
+
+    private:
+        struct segment {
+            std::shared_ptr<const std::string> buffer;
+            const char* first;
+            const char* last;
+
+            // false for the spaces at the end and for the text that failed to parse
+            bool has_block;
+            bool invalid;
+
+            std::size_t size() const {
+                return last - first;
+            }
+        };
+
+        std::vector<segment> segments;
+        x3_ast::source_file result;
+        std::size_t length = 0;
+        std::size_t parsed_size = 0;
+        std::size_t error_offset = 0;
+        std::string error_message;
+
+        bool parse_region(const std::shared_ptr<const std::string>& buffer, std::vector<segment>& parsed, x3_ast::vector<x3_ast::block>& blocks, const char*& error, std::string& message);
+
+};
+
+#endif
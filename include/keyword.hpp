@@ -0,0 +1,149 @@
+#ifndef KEYWORD_HPP
+#define KEYWORD_HPP
+
+#include <initializer_list>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include <boost/spirit/home/x3.hpp>
+
+namespace x3 = boost::spirit::x3;
+
+/*
+ * Keywords of the eddic grammar.
+ *
+ * keyword("while") matches the keyword only if it is not followed by a
+ * character of a name, so that "whiles" is not read as "while" + "s".
+ *
+ * dispatch<Attribute>({"if", "while"}, if_, while_) looks up the keyword at
+ * the current position once (x3::symbols) and only parses the parser of this
+ * keyword, instead of trying each alternative one after another.
+ */
+
+namespace x3_grammar {
+
+namespace keyword_detail {
+
+inline bool is_name_char(char c){
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+template<typename Iterator>
+bool at_boundary(Iterator it, Iterator const& last){
+    return it == last || !is_name_char(*it);
+}
+
+} // end of keyword_detail namespace
+
+struct keyword_parser : x3::parser<keyword_parser> {
+    typedef x3::unused_type attribute_type;
+    static bool const has_attribute = false;
+
+    explicit keyword_parser(const char* str) : str(str) {}
+
+    template<typename Iterator, typename Context, typename RContext, typename Attribute>
+    bool parse(Iterator& first, Iterator const& last, Context const& context, RContext&, Attribute&) const {
+        x3::skip_over(first, last, context);
+
+        Iterator it = first;
+        for(const char* c = str; *c; ++c, ++it){
+            if(it == last || *it != *c){
+                return false;
+            }
+        }
+
+        if(!keyword_detail::at_boundary(it, last)){
+            return false;
+        }
+
+        first = it;
+        return true;
+    }
+
+    const char* str;
+};
+
+inline keyword_parser keyword(const char* str){
+    return keyword_parser(str);
+}
+
+template<typename Attribute, typename... Parsers>
+struct dispatch_parser : x3::parser<dispatch_parser<Attribute, Parsers...>> {
+    typedef Attribute attribute_type;
+    static bool const has_attribute = true;
+
+    dispatch_parser(std::initializer_list<const char*> keywords, Parsers const&... parsers) : parsers(parsers...) {
+        std::size_t index = 0;
+        for(const char* keyword : keywords){
+            this->keywords.add(keyword, index++);
+        }
+    }
+
+    template<typename Iterator, typename Context, typename RContext, typename ActualAttribute>
+    bool parse(Iterator& first, Iterator const& last, Context const& context, RContext& rcontext, ActualAttribute& attr) const {
+        x3::skip_over(first, last, context);
+
+        Iterator it = first;
+        std::size_t index;
+
+        // Already skipped, the keyword itself is matched without skipper
+        if(!keywords.parse(it, last, x3::unused, x3::unused, index) || !keyword_detail::at_boundary(it, last)){
+            return false;
+        }
+
+        if(!parse_keyword(std::integral_constant<std::size_t, 0>(), index, it, last, context, rcontext, attr)){
+            return false;
+        }
+
+        first = it;
+        return true;
+    }
+
+    template<std::size_t I, typename Iterator, typename Context, typename RContext, typename ActualAttribute>
+    bool parse_keyword(std::integral_constant<std::size_t, I>, std::size_t index, Iterator& first, Iterator const& last, Context const& context, RContext& rcontext, ActualAttribute& attr) const {
+        if(index != I){
+            return parse_keyword(std::integral_constant<std::size_t, I + 1>(), index, first, last, context, rcontext, attr);
+        }
+
+        auto const& parser = std::get<I>(parsers);
+
+        typename x3::traits::attribute_of<typename std::decay<decltype(parser)>::type, Context>::type value;
+        if(!parser.parse(first, last, context, rcontext, value)){
+            return false;
+        }
+
+        x3::traits::move_to(value, attr);
+        return true;
+    }
+
+    template<typename Iterator, typename Context, typename RContext, typename ActualAttribute>
+    bool parse_keyword(std::integral_constant<std::size_t, sizeof...(Parsers)>, std::size_t, Iterator&, Iterator const&, Context const&, RContext&, ActualAttribute&) const {
+        return false;
+    }
+
+    x3::symbols<std::size_t> keywords;
+    std::tuple<Parsers...> parsers;
+};
+
+template<typename Attribute, typename... Parsers>
+dispatch_parser<Attribute, typename x3::extension::as_parser<Parsers>::value_type...> dispatch(std::initializer_list<const char*> keywords, Parsers const&... parsers){
+    return {keywords, x3::as_parser(parsers)...};
+}
+
+} // end of grammar namespace
+
+namespace boost { namespace spirit { namespace x3 {
+
+template<>
+struct get_info<x3_grammar::keyword_parser> {
+    typedef std::string result_type;
+
+    std::string operator()(x3_grammar::keyword_parser const& p) const {
+        return '"' + std::string(p.str) + '"';
+    }
+};
+
+}}}
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef LINE_INDEX_HPP
+#define LINE_INDEX_HPP
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/*
+ * Line and column tracking for plain const char* parsing.
+ *
+ * Instead of updating the position on each increment like position_iterator2
+ * does, the offsets of the beginning of the lines are only computed the first
+ * time a position is asked for (e.g. for an expectation failure). Lines and
+ * columns start at 1, tabs are expanded and \n, \r\n and a lone \r end a
+ * line the same way as position_iterator2.
+ */
+class line_index {
+    public:
+        struct position {
+            std::string file;
+            std::size_t line;
+            std::size_t column;
+        };
+
+        line_index(const char* first, const char* last, const std::string& file, std::size_t tab_chars = 4)
+                : first(first), last(last), file(file), tab_chars(tab_chars) {}
+
+        position get(std::size_t offset) const {
+            build();
+
+            offset = std::min(offset, static_cast<std::size_t>(last - first));
+
+            auto line = std::upper_bound(lines.begin(), lines.end(), offset) - 1;
+
+            std::size_t column = 1;
+            for(const char* it = first + *line; it != first + offset; ++it){
+                if(*it == '\t'){
+                    column += tab_chars - (column - 1) % tab_chars;
+                } else if(*it == '\r' && it + 1 != last && *(it + 1) == '\n'){
+                    // \r\n is a single line terminator
+                } else {
+                    ++column;
+                }
+            }
+
+            return {file, static_cast<std::size_t>(line - lines.begin()) + 1, column};
+        }
+
+        position get(const char* where) const {
+            return get(static_cast<std::size_t>(where - first));
+        }
+
+        // The text of the line containing offset, without the line terminator
+        std::string line(std::size_t offset) const {
+            build();
+
+            auto line = std::upper_bound(lines.begin(), lines.end(), offset) - 1;
+
+            const char* begin = first + *line;
+            const char* end = std::find_if(begin, last, [](char c){ return c == '\n' || c == '\r'; });
+
+            return std::string(begin, end);
+        }
+
+        // file:line:column: message, followed by the line and a caret under the column
+        std::string diagnostic(std::size_t offset, const std::string& message) const {
+            auto where = get(offset);
+
+            std::string result = where.file + ":" + std::to_string(where.line) + ":" + std::to_string(where.column) + ": " + message + "\n";
+            result += line(offset) + "\n";
+            result += std::string(where.column - 1, ' ') + "^\n";
+
+            return result;
+        }
+
+    private:
+        const char* first;
+        const char* last;
+        std::string file;
+        std::size_t tab_chars;
+
+        mutable std::vector<std::size_t> lines;
+
+        // A line starts after a \n or a \r not followed by a \n
+        bool line_end(const char* it) const {
+            return *it == '\n' || (*it == '\r' && (it + 1 == last || *(it + 1) != '\n'));
+        }
+
+        void build() const {
+            if(!lines.empty()){
+                return;
+            }
+
+            lines.push_back(0);
+
+            const char* it = first;
+
+#ifdef __SSE2__
+            const __m128i newline = _mm_set1_epi8('\n');
+            const __m128i carriage_return = _mm_set1_epi8('\r');
+
+            for(; last - it >= 16; it += 16){
+                auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+                unsigned mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, newline), _mm_cmpeq_epi8(block, carriage_return)));
+
+                while(mask){
+                    std::size_t offset = (it - first) + __builtin_ctz(mask);
+
+                    if(line_end(first + offset)){
+                        lines.push_back(offset + 1);
+                    }
+
+                    mask &= mask - 1;
+                }
+            }
+#endif
+
+            for(; it != last; ++it){
+                if(line_end(it)){
+                    lines.push_back((it - first) + 1);
+                }
+            }
+        }
+};
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstdio>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Read-only view of the contents of a file.
+ *
+ * Regular files are memory mapped so that the parser can iterate directly on
+ * the mapped pages, without copying them. Everything that cannot be mapped
+ * (pipes, terminals, the standard input given as "-") is read into an owned
+ * buffer instead.
+ */
+class mapped_file {
+    public:
+        typedef const char* iterator;
+
+        mapped_file() = default;
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        ~mapped_file(){
+            close();
+        }
+
+        bool open(const std::string& file){
+            close();
+
+            int fd = file == "-" ? STDIN_FILENO : ::open(file.c_str(), O_RDONLY);
+            if(fd < 0){
+                return false;
+            }
+
+            struct stat st;
+            bool result = ::fstat(fd, &st) == 0;
+
+            if(result){
+                if(S_ISREG(st.st_mode) && st.st_size > 0){
+                    result = map(fd, static_cast<std::size_t>(st.st_size)) || read(fd);
+                } else {
+                    result = read(fd);
+                }
+            }
+
+            if(fd != STDIN_FILENO){
+                ::close(fd);
+            }
+
+            return result;
+        }
+
+        void close(){
+            if(mapped){
+                ::munmap(mapped, mapped_size);
+                mapped = nullptr;
+                mapped_size = 0;
+            }
+
+            buffer.clear();
+            first = last = nullptr;
+        }
+
+        bool is_mapped() const {
+            return mapped;
+        }
+
+        iterator begin() const {
+            return first;
+        }
+
+        iterator end() const {
+            return last;
+        }
+
+        std::size_t size() const {
+            return last - first;
+        }
+
+    private:
+        void* mapped = nullptr;
+        std::size_t mapped_size = 0;
+        std::string buffer;
+
+        iterator first = nullptr;
+        iterator last = nullptr;
+
+        bool map(int fd, std::size_t size){
+            void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(address == MAP_FAILED){
+                return false;
+            }
+
+            // The parser goes through the file once, from the beginning to the end
+            ::madvise(address, size, MADV_SEQUENTIAL);
+
+            mapped = address;
+            mapped_size = size;
+            first = static_cast<const char*>(address);
+            last = first + size;
+
+            return true;
+        }
+
+        bool read(int fd){
+            char chunk[BUFSIZ];
+
+            while(true){
+                ssize_t n = ::read(fd, chunk, sizeof(chunk));
+
+                if(n < 0){
+                    return false;
+                } else if(n == 0){
+                    break;
+                }
+
+                buffer.append(chunk, n);
+            }
+
+            first = buffer.data();
+            last = first + buffer.size();
+
+            return true;
+        }
+};
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef MEMO_HPP
+#define MEMO_HPP
+
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/spirit/home/x3.hpp>
+
+namespace x3 = boost::spirit::x3;
+
+/*
+ * Packrat memoization of rules.
+ *
+ * memo[rule] caches the result of the rule (success, end position and
+ * attribute) for each position it is tried at, so that a rule backtracked
+ * over by several alternatives is only parsed once per position.
+ *
+ * The grammar rules are instantiated for a fixed context, so the table is not
+ * passed through the context but activated for the current thread with a
+ * memo_scope around the parse. Without a memo_scope, memo[rule] just parses
+ * the rule.
+ *
+ * The entries are keyed by the address of the characters, so they are only
+ * valid for one buffer: a memo_scope clears the table when it starts and must
+ * be used for a single parse. The cached attributes are dropped when it ends,
+ * only the statistics are kept, so a memo_scope inside an x3_ast::arena_scope
+ * leaves nothing in the arena.
+ */
+
+namespace x3_grammar {
+
+class memo_table {
+    public:
+        struct statistics {
+            std::string name;
+            std::size_t hits = 0;
+            std::size_t misses = 0;
+        };
+
+        template<typename Iterator, typename Attribute>
+        struct entry {
+            bool success;
+            Iterator end;
+            Attribute attribute;
+        };
+
+        template<typename Iterator, typename Attribute>
+        struct store;
+
+        // The store of a rule, for one iterator type
+        template<typename Iterator, typename Attribute>
+        store<Iterator, Attribute>& get(const void* key, const char* name){
+            auto& base = stores[key];
+
+            if(!base){
+                base.reset(new store<Iterator, Attribute>());
+                base->stats.name = name ? name : "unnamed";
+            }
+
+            return static_cast<store<Iterator, Attribute>&>(*base);
+        }
+
+        void clear(){
+            stores.clear();
+        }
+
+        // Drops the entries of the rules, keeping their statistics
+        void clear_entries(){
+            for(auto& store : stores){
+                store.second->clear_entries();
+            }
+        }
+
+        std::vector<statistics> stats() const {
+            std::vector<statistics> result;
+
+            for(auto& store : stores){
+                result.push_back(store.second->stats);
+            }
+
+            std::sort(result.begin(), result.end(), [](const statistics& lhs, const statistics& rhs){ return lhs.name < rhs.name; });
+
+            return result;
+        }
+
+        void report(std::ostream& out) const {
+            out << std::left << std::setw(32) << "rule"
+                << std::right << std::setw(12) << "hits"
+                << std::setw(12) << "misses"
+                << std::setw(10) << "hit rate" << std::endl;
+
+            for(auto& stat : stats()){
+                std::size_t total = stat.hits + stat.misses;
+
+                out << std::left << std::setw(32) << stat.name
+                    << std::right << std::setw(12) << stat.hits
+                    << std::setw(12) << stat.misses
+                    << std::fixed << std::setprecision(1)
+                    << std::setw(9) << (total ? 100.0 * stat.hits / total : 0.0) << "%" << std::endl;
+            }
+        }
+
+        static memo_table*& current(){
+            static thread_local memo_table* table = nullptr;
+            return table;
+        }
+
+    private:
+        struct store_base {
+            statistics stats;
+
+            virtual ~store_base() = default;
+
+            virtual void clear_entries() = 0;
+        };
+
+        std::unordered_map<const void*, std::unique_ptr<store_base>> stores;
+
+    public:
+        template<typename Iterator, typename Attribute>
+        struct store : store_base {
+            // Keyed by the address of the current character, nullptr at the end
+            std::unordered_map<const void*, entry<Iterator, Attribute>> entries;
+
+            void clear_entries() override {
+                entries.clear();
+            }
+        };
+};
+
+// Enables the memoization for the parse of the current thread during its
+// lifetime, starting from an empty table and ending with only the statistics
+class memo_scope {
+    public:
+        explicit memo_scope(memo_table& table) : table(table), previous(memo_table::current()) {
+            table.clear();
+            memo_table::current() = &table;
+        }
+
+        memo_scope(const memo_scope&) = delete;
+        memo_scope& operator=(const memo_scope&) = delete;
+
+        ~memo_scope(){
+            table.clear_entries();
+            memo_table::current() = previous;
+        }
+
+    private:
+        memo_table& table;
+        memo_table* previous;
+};
+
+namespace memo_detail {
+
+// One key per rule and iterator type, shared by all the memo[rule] of the rule
+template<typename ID, typename Iterator>
+struct key {
+    static const char value;
+};
+
+template<typename ID, typename Iterator>
+const char key<ID, Iterator>::value = 0;
+
+} // end of memo_detail namespace
+
+template<typename Subject>
+struct memo_directive : x3::unary_parser<Subject, memo_directive<Subject>> {
+    typedef x3::unary_parser<Subject, memo_directive<Subject>> base_type;
+    typedef typename Subject::attribute_type attribute_type;
+
+    memo_directive(Subject const& subject) : base_type(subject) {}
+
+    template<typename Iterator, typename Context, typename RContext, typename Attribute>
+    bool parse(Iterator& first, Iterator const& last, Context const& context, RContext& rcontext, Attribute& attr) const {
+        memo_table* table = memo_table::current();
+
+        if(!table){
+            return this->subject.parse(first, last, context, rcontext, attr);
+        }
+
+        auto& store = table->get<Iterator, attribute_type>(&memo_detail::key<typename Subject::id, Iterator>::value, this->subject.name);
+
+        const void* position = first == last ? nullptr : &*first;
+
+        auto it = store.entries.find(position);
+
+        if(it != store.entries.end()){
+            ++store.stats.hits;
+
+            if(it->second.success){
+                first = it->second.end;
+
+                attribute_type copy = it->second.attribute;
+                x3::traits::move_to(copy, attr);
+            }
+
+            return it->second.success;
+        }
+
+        ++store.stats.misses;
+
+        attribute_type attribute;
+        bool success = this->subject.parse(first, last, context, rcontext, attribute);
+
+        auto& entry = store.entries[position];
+        entry.success = success;
+        entry.end = first;
+
+        if(success){
+            entry.attribute = attribute;
+            x3::traits::move_to(attribute, attr);
+        }
+
+        return success;
+    }
+};
+
+struct memo_gen {
+    template<typename Subject>
+    memo_directive<typename x3::extension::as_parser<Subject>::value_type> operator[](Subject const& subject) const {
+        return {x3::as_parser(subject)};
+    }
+};
+
+memo_gen const memo = memo_gen();
+
+} // end of grammar namespace
+
+#endif
@@ -0,0 +1,589 @@
+#ifndef MONSTER_HPP
+#define MONSTER_HPP
+
+#include <string>
+
+#define BOOST_SPIRIT_X3_NO_RTTI
+
+#include <boost/spirit/home/x3.hpp>
+#include <boost/spirit/home/x3/support/ast/variant.hpp>
+#include <boost/fusion/include/adapt_struct.hpp>
+#include <boost/spirit/include/classic_position_iterator.hpp>
+
+#include "arena.hpp"
+#include "keyword.hpp"
+#include "skipper.hpp"
+#include "symbol.hpp"
+#include "view.hpp"
+
+namespace x3 = boost::spirit::x3;
+
+// Plain iterators, line and column are resolved on demand with a line_index
+typedef const char* pos_iterator_type;
+typedef boost::spirit::classic::position_iterator2<pos_iterator_type> position_iterator_type;
+
+namespace x3_ast {
+
+// The forward_ast nodes and the containers are allocated in the current arena, see arena.hpp
+
+// The names and the literals are views into the parsed input, their offset
+// in the input gives their position (see line_index.hpp). The names of the
+// types are interned instead, to be compared as integers (see symbol.hpp).
+typedef boost::string_view string_view;
+
+struct simple_type;
+struct array_type;
+struct pointer_type;
+struct template_type;
+
+typedef x3::variant<
+        simple_type,
+        x3::forward_ast<array_type>,
+        x3::forward_ast<template_type>,
+        x3::forward_ast<pointer_type>
+    > type_t;
+
+struct simple_type {
+    bool const_;
+    symbol base_type;
+};
+
+struct array_type {
+    type_t base_type;
+
+    static void* operator new(std::size_t size){ return arena::allocate_node(size); }
+    static void operator delete(void* node){ arena::deallocate_node(node); }
+};
+
+struct pointer_type {
+    type_t base_type;
+
+    static void* operator new(std::size_t size){ return arena::allocate_node(size); }
+    static void operator delete(void* node){ arena::deallocate_node(node); }
+};
+
+struct template_type {
+    symbol base_type;
+    vector<type_t> template_types;
+
+    static void* operator new(std::size_t size){ return arena::allocate_node(size); }
+    static void operator delete(void* node){ arena::deallocate_node(node); }
+};
+
+struct integer_literal {
+    int value;
+};
+
+struct integer_suffix_literal {
+    int value;
+    string_view suffix;
+};
+
+struct float_literal {
+    double value;
+};
+
+struct string_literal {
+    string_view value;
+};
+
+struct char_literal {
+    char value;
+};
+
+struct variable_value {
+    string_view variable_name;
+};
+
+typedef x3::variant<
+            integer_literal,
+            integer_suffix_literal,
+            float_literal,
+            string_literal,
+            char_literal,
+            variable_value
+        > value_t;
+
+struct foreach;
+struct while_;
+struct do_while;
+struct foreach_in;
+struct variable_declaration;
+struct struct_declaration;
+struct array_declaration;
+struct return_;
+struct delete_;
+struct if_;
+
+typedef x3::variant<
+        foreach,
+        foreach_in,
+        if_,
+        while_,
+        do_while,
+        return_,
+        delete_,
+        variable_declaration,
+        struct_declaration,
+        array_declaration
+    > instruction;
+
+struct while_ {
+    value_t condition;
+    vector<instruction> instructions;
+};
+
+struct do_while {
+    value_t condition;
+    vector<instruction> instructions;
+};
+
+struct foreach_in {
+    type_t variable_type;
+    string_view variable_name;
+    string_view array_name;
+    vector<instruction> instructions;
+};
+
+struct foreach {
+    type_t variable_type;
+    string_view variable_name;
+    int from;
+    int to;
+    vector<instruction> instructions;
+};
+
+struct variable_declaration {
+    type_t variable_type;
+    string_view variable_name;
+    boost::optional<x3_ast::value_t> value;
+};
+
+struct struct_declaration {
+    type_t variable_type;
+    string_view variable_name;
+    vector<value_t> values;
+};
+
+struct array_declaration {
+    type_t array_type;
+    string_view array_name;
+    value_t size;
+};
+
+struct return_ {
+    int fake_;
+    value_t return_value;
+};
+
+struct delete_ {
+    int fake_;
+    value_t value;
+};
+
+struct else_if {
+    value_t condition;
+    vector<instruction> instructions;
+};
+
+struct else_ {
+    int fake_;
+    vector<instruction> instructions;
+};
+
+struct if_ {
+    value_t condition;
+    vector<instruction> instructions;
+    vector<else_if> else_ifs;
+    boost::optional<x3_ast::else_> else_;
+};
+
+struct function_parameter {
+    type_t  parameter_type;
+    string_view parameter_name;
+};
+
+struct template_function_declaration {
+    vector<symbol> template_types;
+    type_t return_type;
+    string_view name;
+    vector<function_parameter> parameters;
+    vector<instruction> instructions;
+};
+
+struct global_variable_declaration {
+    type_t variable_type;
+    string_view variable_name;
+    boost::optional<x3_ast::value_t> value;
+};
+
+struct global_array_declaration {
+    type_t array_type;
+    string_view array_name;
+    value_t size;
+};
+
+struct standard_import {
+    string_view file;
+};
+
+struct import {
+    string_view file;
+};
+
+struct member_declaration {
+    type_t type;
+    string_view name;
+};
+
+typedef x3::variant<
+        member_declaration,
+        array_declaration,
+        template_function_declaration
+    > struct_block;
+
+struct template_struct {
+    vector<symbol> template_types;
+    symbol name;
+    boost::optional<type_t> parent_type;
+    vector<struct_block> blocks;
+};
+
+typedef x3::variant<
+        standard_import,
+        import,
+        template_struct,
+        template_function_declaration,
+        global_array_declaration,
+        global_variable_declaration
+    > block;
+
+struct source_file {
+    vector<block> blocks;
+};
+
+} //end of x3_ast namespace
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::source_file,
+    (x3_ast::vector<x3_ast::block>, blocks)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::simple_type,
+    (bool, const_)
+    (x3_ast::symbol, base_type)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::array_type,
+    (x3_ast::type_t, base_type)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::pointer_type,
+    (x3_ast::type_t, base_type)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::template_type,
+    (x3_ast::symbol, base_type)
+    (x3_ast::vector<x3_ast::type_t>, template_types)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::integer_literal,
+    (int, value)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::integer_suffix_literal,
+    (int, value)
+    (x3_ast::string_view, suffix)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::float_literal,
+    (double, value)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::string_literal,
+    (x3_ast::string_view, value)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::char_literal,
+    (char, value)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::variable_value,
+    (x3_ast::string_view, variable_name)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::foreach_in,
+    (x3_ast::type_t, variable_type)
+    (x3_ast::string_view, variable_name)
+    (x3_ast::string_view, array_name)
+    (x3_ast::vector<x3_ast::instruction>, instructions)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::foreach,
+    (x3_ast::type_t, variable_type)
+    (x3_ast::string_view, variable_name)
+    (int, from)
+    (int, to)
+    (x3_ast::vector<x3_ast::instruction>, instructions)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::while_,
+    (x3_ast::value_t, condition)
+    (x3_ast::vector<x3_ast::instruction>, instructions)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::do_while,
+    (x3_ast::vector<x3_ast::instruction>, instructions)
+    (x3_ast::value_t, condition)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::variable_declaration,
+    (x3_ast::type_t, variable_type)
+    (x3_ast::string_view, variable_name)
+    (boost::optional<x3_ast::value_t>, value)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::struct_declaration,
+    (x3_ast::type_t, variable_type)
+    (x3_ast::string_view, variable_name)
+    (x3_ast::vector<x3_ast::value_t>, values)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::array_declaration,
+    (x3_ast::type_t, array_type)
+    (x3_ast::string_view, array_name)
+    (x3_ast::value_t, size)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::return_,
+    (int, fake_)
+    (x3_ast::value_t, return_value)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::delete_,
+    (int, fake_)
+    (x3_ast::value_t, value)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::else_if,
+    (x3_ast::value_t, condition)
+    (x3_ast::vector<x3_ast::instruction>, instructions)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::else_,
+    (int, fake_)
+    (x3_ast::vector<x3_ast::instruction>, instructions)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::if_,
+    (x3_ast::value_t, condition)
+    (x3_ast::vector<x3_ast::instruction>, instructions)
+    (x3_ast::vector<x3_ast::else_if>, else_ifs)
+    (boost::optional<x3_ast::else_>, else_)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::template_function_declaration,
+    (x3_ast::vector<x3_ast::symbol>, template_types)
+    (x3_ast::type_t, return_type)
+    (x3_ast::string_view, name)
+    (x3_ast::vector<x3_ast::function_parameter>, parameters)
+    (x3_ast::vector<x3_ast::instruction>, instructions)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::function_parameter,
+    (x3_ast::type_t, parameter_type)
+    (x3_ast::string_view, parameter_name)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::global_variable_declaration,
+    (x3_ast::type_t, variable_type)
+    (x3_ast::string_view, variable_name)
+    (boost::optional<x3_ast::value_t>, value)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::global_array_declaration,
+    (x3_ast::type_t, array_type)
+    (x3_ast::string_view, array_name)
+    (x3_ast::value_t, size)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::import,
+    (x3_ast::string_view, file)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::standard_import,
+    (x3_ast::string_view, file)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::member_declaration,
+    (x3_ast::type_t, type)
+    (x3_ast::string_view, name)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::template_struct,
+    (x3_ast::vector<x3_ast::symbol>, template_types)
+    (x3_ast::symbol, name)
+    (boost::optional<x3_ast::type_t>, parent_type)
+    (x3_ast::vector<x3_ast::struct_block>, blocks)
+)
+
+namespace x3_grammar {
+    typedef x3::identity<struct source_file> source_file_id;
+    typedef x3::identity<struct blocks> blocks_id;
+    typedef x3::identity<struct block> block_id;
+
+    typedef x3::identity<struct type_t> type_id;
+    typedef x3::identity<struct base_type> base_type_id;
+    typedef x3::identity<struct simple_type> simple_type_id;
+    typedef x3::identity<struct template_type> template_type_id;
+
+    typedef x3::identity<struct integer_literal> integer_literal_id;
+    typedef x3::identity<struct integer_suffix_literal> integer_suffix_literal_id;
+    typedef x3::identity<struct float_literal> float_literal_id;
+    typedef x3::identity<struct string_literal> string_literal_id;
+    typedef x3::identity<struct char_literal> char_literal_id;
+    typedef x3::identity<struct variable_value> variable_value_id;
+    typedef x3::identity<struct value_t> value_id;
+
+    typedef x3::identity<struct instruction> instruction_id;
+    typedef x3::identity<struct foreach> foreach_id;
+    typedef x3::identity<struct while_> while_id;
+    typedef x3::identity<struct do_while> do_while_id;
+    typedef x3::identity<struct declaration> declaration_id;
+    typedef x3::identity<struct array_declaration> array_declaration_id;
+    typedef x3::identity<struct return_> return_id;
+    typedef x3::identity<struct delete_> delete_id;
+    typedef x3::identity<struct if_> if_id;
+    typedef x3::identity<struct else_if> else_if_id;
+    typedef x3::identity<struct else_> else_id;
+
+    typedef x3::identity<struct function_parameter> function_parameter_id;
+    typedef x3::identity<struct template_function_declaration> template_function_declaration_id;
+    typedef x3::identity<struct global_variable_declaration> global_variable_declaration_id;
+    typedef x3::identity<struct global_array_declaration> global_array_declaration_id;
+    typedef x3::identity<struct import> import_id;
+    typedef x3::identity<struct standard_import> standard_import_id;
+    typedef x3::identity<struct member_declaration> member_declaration_id;
+    typedef x3::identity<struct template_struct> template_struct_id;
+
+    // The rules used across translation units. Their parse_rule is only
+    // declared here and explicitly instantiated in the unit defining them
+    // (see MONSTER_INSTANTIATE).
+
+    typedef x3::rule<source_file_id, x3_ast::source_file> source_file_rule;
+    typedef x3::rule<blocks_id, x3_ast::vector<x3_ast::block>> blocks_rule;
+    typedef x3::rule<block_id, x3_ast::block> block_rule;
+    typedef x3::rule<type_id, x3_ast::type_t> type_rule;
+    typedef x3::rule<value_id, x3_ast::value_t> value_rule;
+    typedef x3::rule<instruction_id, x3_ast::instruction> instruction_rule;
+    typedef x3::rule<array_declaration_id, x3_ast::array_declaration> array_declaration_rule;
+
+    source_file_rule const source_file("source_file");
+    blocks_rule const blocks("blocks");
+    block_rule const block("block");
+
+    type_rule const type("type");
+    x3::rule<base_type_id, x3_ast::type_t> const base_type("base_type");
+    x3::rule<simple_type_id, x3_ast::simple_type> const simple_type("simple_type");
+    x3::rule<template_type_id, x3_ast::template_type> const template_type("template_type");
+
+    x3::rule<integer_literal_id, x3_ast::integer_literal> const integer_literal("integer_literal");
+    x3::rule<integer_suffix_literal_id, x3_ast::integer_suffix_literal> const integer_suffix_literal("integer_suffix_literal");
+    x3::rule<float_literal_id, x3_ast::float_literal> const float_literal("float_literal");
+    x3::rule<string_literal_id, x3_ast::string_literal> const string_literal("string_literal");
+    x3::rule<char_literal_id, x3_ast::char_literal> const char_literal("char_literal");
+    x3::rule<variable_value_id, x3_ast::variable_value> const variable_value("variable_value");
+    value_rule const value("value");
+
+    instruction_rule const instruction("instruction");
+    x3::rule<foreach_id, x3_ast::instruction> const foreach("foreach");
+    x3::rule<while_id, x3_ast::while_> const while_("while");
+    x3::rule<do_while_id, x3_ast::do_while> const do_while("do_while");
+    x3::rule<declaration_id, x3_ast::instruction> const declaration("declaration");
+    array_declaration_rule const array_declaration("array_declaration");
+    x3::rule<return_id, x3_ast::return_> const return_("return");
+    x3::rule<delete_id, x3_ast::delete_> const delete_("delete");
+    x3::rule<if_id, x3_ast::if_> const if_("if");
+    x3::rule<else_if_id, x3_ast::else_if> const else_if("else_if");
+    x3::rule<else_id, x3_ast::else_> const else_("else");
+
+    x3::rule<function_parameter_id, x3_ast::function_parameter> const function_parameter("function_parameter");
+    x3::rule<template_function_declaration_id, x3_ast::template_function_declaration> const template_function_declaration("template_function_declaration");
+    x3::rule<global_variable_declaration_id, x3_ast::global_variable_declaration> const global_variable_declaration("global_variable_declaration");
+    x3::rule<global_array_declaration_id, x3_ast::global_array_declaration> const global_array_declaration("global_array_declaration");
+    x3::rule<standard_import_id, x3_ast::standard_import> const standard_import("standard_import");
+    x3::rule<import_id, x3_ast::import> const import("import");
+    x3::rule<member_declaration_id, x3_ast::member_declaration> const member_declaration("member_declaration");
+    x3::rule<template_struct_id, x3_ast::template_struct> const template_struct("template_struct");
+
+    skipper_parser const skipper{};
+
+    typedef std::decay<decltype(skipper)>::type skipper_type;
+    typedef x3::phrase_parse_context<skipper_type>::type context_type;
+
+    auto const name_chars =
+        x3::lexeme[(x3::alpha | '_') >> *(x3::alnum | '_')];
+
+    auto const identifier =
+        view[name_chars];
+
+    auto const type_name =
+        intern[name_chars];
+
+    BOOST_SPIRIT_DECLARE(
+        source_file_rule,
+        blocks_rule,
+        block_rule,
+        type_rule,
+        value_rule,
+        instruction_rule,
+        array_declaration_rule
+    );
+
+    auto const parser = source_file;
+
+} // end of grammar namespace
+
+// The rules are instantiated for pos_iterator_type and, in the units compiled
+// with MONSTER_POSITION_ITERATOR (only linked in bench_parse), for
+// position_iterator_type as well
+#ifdef MONSTER_POSITION_ITERATOR
+#define MONSTER_INSTANTIATE(rule_type)                                          \
+    BOOST_SPIRIT_INSTANTIATE(rule_type, pos_iterator_type, context_type);       \
+    BOOST_SPIRIT_INSTANTIATE(rule_type, position_iterator_type, context_type)
+#else
+#define MONSTER_INSTANTIATE(rule_type)                                          \
+    BOOST_SPIRIT_INSTANTIATE(rule_type, pos_iterator_type, context_type)
+#endif
+
+#endif
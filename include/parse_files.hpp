@@ -0,0 +1,56 @@
+#ifndef PARSE_FILES_HPP
+#define PARSE_FILES_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "monster.hpp"
+#include "ast_cache.hpp"
+#include "mapped_file.hpp"
+
+/*
+ * Parsing of eddic files with the monster grammar.
+ *
+ * parse_files() parses the files in parallel on a work stealing pool. Each
+ * worker allocates the ASTs of its files in its own arena, the results are
+ * given in the order of the paths.
+ *
+ * parse_split_file() parses a single file in parallel instead: the file is
+ * split after the '}' closing the top-level blocks and the parts are parsed
+ * as lists of blocks, then joined in one AST.
+ *
+ * With a cache, the AST of a file already parsed is loaded from the cache
+ * and the AST of the others is stored into it after the parse.
+ *
+ * With recover, the parse goes on after the errors (include/recovery.hpp): the
+ * diagnostic has all of them and the AST has the blocks parsed around them.
+ */
+
+struct parsed_file {
+    std::string path;
+    bool success = false;
+
+    // file:line:column: error for each error, empty if the parse succeeded
+    std::string diagnostic;
+
+    // The views of the AST point into the input
+    std::unique_ptr<mapped_file> input;
+    x3_ast::source_file ast;
+};
+
+struct parsed_files {
+    // The arenas of the workers, holding the ASTs, declared first to outlive them
+    std::vector<std::unique_ptr<x3_ast::arena>> arenas;
+
+    std::vector<parsed_file> files;
+};
+
+// Parses file.path into file, the AST is allocated in the current arena
+bool parse_file(parsed_file& file, const x3_ast::ast_cache* cache = nullptr, bool recover = false);
+
+parsed_files parse_files(const std::vector<std::string>& paths, std::size_t threads, const x3_ast::ast_cache* cache = nullptr, bool recover = false);
+
+parsed_files parse_split_file(const std::string& path, std::size_t threads);
+
+#endif
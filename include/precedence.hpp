@@ -0,0 +1,146 @@
+#ifndef PRECEDENCE_HPP
+#define PRECEDENCE_HPP
+
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include <boost/spirit/home/x3.hpp>
+
+namespace x3 = boost::spirit::x3;
+
+/*
+ * Precedence climbing of the binary operators.
+ *
+ * precedence<Value, Expression>(operand, operators) parses the operands
+ * separated by the binary operators of the table in a single loop, instead of
+ * one rule per level of precedence. The operators of a same level are left
+ * associative and collected in one Expression (first and operations, each
+ * operation having an op and a value), a higher level is an Expression nested
+ * as the value of an operation and a lower level wraps the expression parsed
+ * so far as its first value. An operand alone is given as is, without an
+ * Expression around it.
+ *
+ * The tokens are matched after the skipper, the longest one wins (<= before
+ * <). An operator must be followed by an operand (expectation point).
+ */
+
+namespace x3_grammar {
+
+template<typename Operator>
+struct binary_operator {
+    const char* token;
+    Operator op;
+    unsigned precedence;
+};
+
+template<typename Operand, typename Value, typename Expression, typename Operator>
+struct precedence_parser : x3::parser<precedence_parser<Operand, Value, Expression, Operator>> {
+    typedef Value attribute_type;
+    static bool const has_attribute = true;
+
+    Operand operand;
+    const binary_operator<Operator>* operators;
+    std::size_t size;
+
+    precedence_parser(Operand const& operand, const binary_operator<Operator>* operators, std::size_t size) : operand(operand), operators(operators), size(size) {}
+
+    template<typename Iterator, typename Context, typename RContext>
+    bool parse(Iterator& first, Iterator const& last, Context const& context, RContext& rcontext, Value& attr) const {
+        const binary_operator<Operator>* next;
+        Iterator at;
+
+        return parse_level(first, last, context, rcontext, attr, 0, next, at);
+    }
+
+    template<typename Iterator, typename Context, typename RContext, typename Attribute>
+    bool parse(Iterator& first, Iterator const& last, Context const& context, RContext& rcontext, Attribute& attr) const {
+        Value value;
+
+        if(parse(first, last, context, rcontext, value)){
+            x3::traits::move_to(value, attr);
+            return true;
+        }
+
+        return false;
+    }
+
+    private:
+        // The longest operator at first, after the skipper
+        template<typename Iterator, typename Context>
+        const binary_operator<Operator>* match(Iterator& first, Iterator const& last, Context const& context) const {
+            x3::skip_over(first, last, context);
+
+            const binary_operator<Operator>* best = nullptr;
+            std::size_t best_length = 0;
+
+            for(std::size_t i = 0; i < size; ++i){
+                const char* token = operators[i].token;
+
+                Iterator it = first;
+                std::size_t length = 0;
+                while(token[length] && it != last && *it == token[length]){
+                    ++it;
+                    ++length;
+                }
+
+                if(!token[length] && length > best_length){
+                    best = &operators[i];
+                    best_length = length;
+                }
+            }
+
+            return best;
+        }
+
+        // Parses the operands joined by the operators of at least min_precedence.
+        // The operator after them (if any) is given in next, at its position in at.
+        template<typename Iterator, typename Context, typename RContext>
+        bool parse_level(Iterator& first, Iterator const& last, Context const& context, RContext& rcontext, Value& attr, unsigned min_precedence, const binary_operator<Operator>*& next, Iterator& at) const {
+            if(!operand.parse(first, last, context, rcontext, attr)){
+                return false;
+            }
+
+            at = first;
+            next = match(at, last, context);
+
+            while(next && next->precedence >= min_precedence){
+                unsigned level = next->precedence;
+
+                Expression expression;
+                expression.first = std::move(attr);
+
+                // The operators of the same level are chained in the same expression
+                do {
+                    Iterator it = at;
+                    std::advance(it, std::strlen(next->token));
+
+                    typename decltype(expression.operations)::value_type operation;
+                    operation.op = next->op;
+
+                    Value value;
+                    if(!parse_level(it, last, context, rcontext, value, level + 1, next, at)){
+                        boost::throw_exception(x3::expectation_failure<Iterator>(it, x3::what(operand)));
+                    }
+
+                    operation.value = std::move(value);
+                    expression.operations.push_back(std::move(operation));
+
+                    first = it;
+                } while(next && next->precedence == level);
+
+                attr = std::move(expression);
+            }
+
+            return true;
+        }
+};
+
+template<typename Value, typename Expression, typename Operand, typename Operator, std::size_t N>
+precedence_parser<typename x3::extension::as_parser<Operand>::value_type, Value, Expression, Operator> precedence(Operand const& operand, const binary_operator<Operator> (&operators)[N]){
+    return {x3::as_parser(operand), operators, N};
+}
+
+} // end of grammar namespace
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef PROBLEM_8_HPP
+#define PROBLEM_8_HPP
+
+#include <string>
+#include <vector>
+
+#include <boost/spirit/home/x3.hpp>
+#include <boost/spirit/home/x3/support/ast/variant.hpp>
+#include <boost/fusion/include/adapt_struct.hpp>
+
+#include "flat_expression.hpp"
+#include "precedence.hpp"
+
+/*
+ * The AST and the grammar of the expressions of problem_8, shared with
+ * bench_precedence and bench_flat_expression.
+ */
+
+namespace x3 = boost::spirit::x3;
+
+namespace x3_ast {
+
+enum Operator  { ADD, SUB, DIV, MUL, MOD, AND, OR, EQUALS, NOT_EQUALS, LESS, LESS_EQUALS, GREATER, GREATER_EQUALS };
+
+struct variable_value {
+    std::string variable_name;
+};
+
+struct expression;
+
+typedef x3::variant<variable_value, x3::forward_ast<expression>> value;
+
+typedef x3::variant<value> operation_value;
+
+struct operation {
+    Operator op;
+    operation_value value;
+};
+
+struct expression {
+    value first;
+    std::vector<operation> operations;
+};
+
+// The same expression in contiguous arrays
+typedef flat_expression<variable_value, Operator> flat_value;
+
+} //end of x3_ast namespace
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::variable_value, 
+    (std::string, variable_name)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::operation, 
+    (x3_ast::Operator, op)
+    (x3_ast::operation_value, value)
+)
+
+BOOST_FUSION_ADAPT_STRUCT(
+    x3_ast::expression, 
+    (x3_ast::value, first)
+    (std::vector<x3_ast::operation>, operations)
+)
+
+namespace x3_grammar {
+    struct value_class {};
+    struct variable_value_class {};
+    struct cast_expression_class {};
+
+    x3::rule<variable_value_class, x3_ast::variable_value> const variable_value("variable_value");
+    x3::rule<cast_expression_class, x3_ast::value> const cast_expression("cast_expression");
+    x3::rule<value_class, x3_ast::value> const value("value");
+
+    auto const identifier =
+                x3::lexeme[(x3::char_('_') >> *(x3::alnum | x3::char_('_')))]
+            |   x3::lexeme[(x3::alpha >> *(x3::alnum | x3::char_('_')))]
+            ;
+
+    auto const variable_value_def = identifier;
+
+    auto const cast_expression_def =
+            variable_value
+        |   ('(' > value > ')');
+
+    // All the binary operators of eddic, by increasing precedence
+    x3_grammar::binary_operator<x3_ast::Operator> const binary_operators[] = {
+        {"||", x3_ast::Operator::OR, 1},
+        {"&&", x3_ast::Operator::AND, 2},
+        {"==", x3_ast::Operator::EQUALS, 3},
+        {"!=", x3_ast::Operator::NOT_EQUALS, 3},
+        {"<", x3_ast::Operator::LESS, 4},
+        {"<=", x3_ast::Operator::LESS_EQUALS, 4},
+        {">", x3_ast::Operator::GREATER, 4},
+        {">=", x3_ast::Operator::GREATER_EQUALS, 4},
+        {"+", x3_ast::Operator::ADD, 5},
+        {"-", x3_ast::Operator::SUB, 5},
+        {"*", x3_ast::Operator::MUL, 6},
+        {"/", x3_ast::Operator::DIV, 6},
+        {"%", x3_ast::Operator::MOD, 6}
+    };
+
+    // Instead of one rule per level (additive_expression, multiplicative_expression, ...)
+    auto const value_def = precedence<x3_ast::value, x3_ast::expression>(cast_expression, binary_operators);
+
+    BOOST_SPIRIT_DEFINE(
+        value,
+        cast_expression,
+        variable_value
+    );
+
+} // end of grammar namespace
+
+// Walks both the tree and the flat_value
+struct operand_counter {
+    typedef std::size_t result_type;
+
+    std::size_t operator()(const x3_ast::variable_value&) const {
+        return 1;
+    }
+
+    // boost::apply_visitor for the variants, x3_ast::flat_value::value_ref has its own
+    template<typename Value>
+    std::size_t operator()(const Value& value) const {
+        using boost::apply_visitor;
+        return apply_visitor(*this, value);
+    }
+
+    template<typename Expression>
+    std::size_t operator()(const x3::forward_ast<Expression>& expression) const {
+        return count(expression.get());
+    }
+
+    std::size_t operator()(const x3_ast::flat_value::expression_ref& expression) const {
+        return count(expression);
+    }
+
+    template<typename Expression>
+    std::size_t count(const Expression& expression) const {
+        std::size_t operands = (*this)(expression.first);
+
+        for(auto&& operation : expression.operations){
+            operands += (*this)(operation.value);
+        }
+
+        return operands;
+    }
+};
+
+#endif
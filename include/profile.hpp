@@ -0,0 +1,354 @@
+#ifndef PROFILE_HPP
+#define PROFILE_HPP
+
+#include <boost/spirit/home/x3.hpp>
+
+/*
+ * Profiling of the rules of the monster grammar.
+ *
+ * The grammar defines its rules with MONSTER_DEFINE. Built with
+ * MONSTER_PROFILE (make monster_profile), it wraps the parse of each rule with
+ * a rule_probe counting the calls, the successes, the failures, the bytes
+ * consumed and backtracked (the furthest position reached by the nested rules
+ * of a failed or shorter parse) and the inclusive and exclusive time of the
+ * rule. Without MONSTER_PROFILE (nor MONSTER_NO_EXCEPTIONS), MONSTER_DEFINE is
+ * BOOST_SPIRIT_DEFINE and nothing of this is compiled in.
+ *
+ * Each thread profiles its own parses, the profiles are merged when the
+ * threads end or when the report is written.
+ *
+ * With MONSTER_NO_EXCEPTIONS, MONSTER_DEFINE also makes the rules fail once an
+ * expectation failed (see expect.hpp).
+ */
+
+#if !defined(MONSTER_PROFILE) && !defined(MONSTER_NO_EXCEPTIONS)
+
+#define MONSTER_DEFINE(...) BOOST_SPIRIT_DEFINE(__VA_ARGS__)
+
+#else
+
+#include "expect.hpp"
+
+#ifdef MONSTER_PROFILE
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <boost/spirit/include/classic_position_iterator.hpp>
+
+namespace x3_grammar {
+
+class rule_profile {
+    public:
+        struct statistics {
+            std::string name;
+            std::size_t calls = 0;
+            std::size_t successes = 0;
+            std::size_t failures = 0;
+            std::size_t consumed = 0;
+            std::size_t backtracked = 0;
+            std::uint64_t inclusive = 0;
+            std::uint64_t exclusive = 0;
+        };
+
+        rule_profile(){
+            nodes.push_back({0, 0, 0, {}});
+        }
+
+        rule_profile(const rule_profile&) = delete;
+        rule_profile& operator=(const rule_profile&) = delete;
+
+        ~rule_profile(){
+            merge();
+        }
+
+        // The profile of the current thread
+        static rule_profile& current(){
+            static thread_local rule_profile profile;
+            return profile;
+        }
+
+        // The index of a rule, the same for all the threads and iterator types
+        static std::size_t rule_id(const char* name){
+            auto& shared = global();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+
+            auto it = std::find_if(shared.names.begin(), shared.names.end(), [name](const char* other){ return std::strcmp(name, other) == 0; });
+            if(it != shared.names.end()){
+                return it - shared.names.begin();
+            }
+
+            shared.names.push_back(name);
+            return shared.names.size() - 1;
+        }
+
+        void enter(std::size_t rule, const char* position){
+            std::size_t parent = stack.empty() ? 0 : stack.back().node;
+
+            if(rule >= rules.size()){
+                rules.resize(rule + 1);
+                active.resize(rule + 1);
+            }
+
+            ++active[rule];
+
+            stack.push_back({rule, child(parent, rule), position, position, 0, clock::now()});
+        }
+
+        void exit(bool success, const char* position){
+            frame current = stack.back();
+            stack.pop_back();
+
+            std::uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - current.start_time).count();
+
+            auto& stats = rules[current.rule];
+            const char* end = success ? position : current.start;
+            const char* reached = std::max(current.furthest, end);
+
+            ++stats.calls;
+            ++(success ? stats.successes : stats.failures);
+            stats.consumed += end - current.start;
+            stats.backtracked += reached - end;
+            stats.exclusive += elapsed - current.children;
+            nodes[current.node].exclusive += elapsed - current.children;
+
+            // Only the outermost call of a recursive rule counts for the inclusive time
+            if(--active[current.rule] == 0){
+                stats.inclusive += elapsed;
+            }
+
+            if(!stack.empty()){
+                stack.back().children += elapsed;
+                stack.back().furthest = std::max(stack.back().furthest, reached);
+            }
+        }
+
+        // Merges the profile of the current thread and writes the table of the rules by exclusive time
+        static void report(std::ostream& out){
+            current().merge();
+
+            auto& shared = global();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+
+            auto sorted = shared.rules;
+            for(std::size_t rule = 0; rule < sorted.size(); ++rule){
+                sorted[rule].name = shared.names[rule];
+            }
+
+            std::sort(sorted.begin(), sorted.end(), [](const statistics& lhs, const statistics& rhs){ return lhs.exclusive > rhs.exclusive; });
+
+            out << std::left << std::setw(32) << "rule"
+                << std::right << std::setw(12) << "calls"
+                << std::setw(12) << "successes"
+                << std::setw(12) << "failures"
+                << std::setw(14) << "consumed"
+                << std::setw(14) << "backtracked"
+                << std::setw(12) << "incl. ms"
+                << std::setw(12) << "excl. ms" << std::endl;
+
+            for(auto& stats : sorted){
+                if(!stats.calls){
+                    continue;
+                }
+
+                out << std::left << std::setw(32) << stats.name
+                    << std::right << std::setw(12) << stats.calls
+                    << std::setw(12) << stats.successes
+                    << std::setw(12) << stats.failures
+                    << std::setw(14) << stats.consumed
+                    << std::setw(14) << stats.backtracked
+                    << std::fixed << std::setprecision(2)
+                    << std::setw(12) << stats.inclusive / 1e6
+                    << std::setw(12) << stats.exclusive / 1e6 << std::endl;
+            }
+        }
+
+        // Writes the exclusive time (in ns) of each stack of rules, for flamegraph.pl
+        static void folded(std::ostream& out){
+            current().merge();
+
+            auto& shared = global();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+
+            for(auto& stack : shared.stacks){
+                out << stack.first << " " << stack.second << "\n";
+            }
+        }
+
+    private:
+        typedef std::chrono::steady_clock clock;
+
+        struct frame {
+            std::size_t rule;
+            std::size_t node;
+            const char* start;
+            const char* furthest;
+            std::uint64_t children;
+            clock::time_point start_time;
+        };
+
+        // The call tree, the node 0 is the root
+        struct node {
+            std::size_t rule;
+            std::size_t parent;
+            std::uint64_t exclusive;
+            std::vector<std::pair<std::size_t, std::size_t>> children;
+        };
+
+        struct shared_profile {
+            std::mutex mutex;
+            std::vector<const char*> names;
+            std::vector<statistics> rules;
+            std::map<std::string, std::uint64_t> stacks;
+        };
+
+        std::vector<frame> stack;
+        std::vector<node> nodes;
+        std::vector<statistics> rules;
+        std::vector<std::size_t> active;
+
+        static shared_profile& global(){
+            static shared_profile profile;
+            return profile;
+        }
+
+        std::size_t child(std::size_t parent, std::size_t rule){
+            for(auto& child : nodes[parent].children){
+                if(child.first == rule){
+                    return child.second;
+                }
+            }
+
+            nodes.push_back({rule, parent, 0, {}});
+            nodes[parent].children.emplace_back(rule, nodes.size() - 1);
+
+            return nodes.size() - 1;
+        }
+
+        void merge(){
+            auto& shared = global();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+
+            if(shared.rules.size() < rules.size()){
+                shared.rules.resize(rules.size());
+            }
+
+            for(std::size_t rule = 0; rule < rules.size(); ++rule){
+                auto& lhs = shared.rules[rule];
+                auto& rhs = rules[rule];
+
+                lhs.calls += rhs.calls;
+                lhs.successes += rhs.successes;
+                lhs.failures += rhs.failures;
+                lhs.consumed += rhs.consumed;
+                lhs.backtracked += rhs.backtracked;
+                lhs.inclusive += rhs.inclusive;
+                lhs.exclusive += rhs.exclusive;
+            }
+
+            for(std::size_t n = 1; n < nodes.size(); ++n){
+                if(!nodes[n].exclusive){
+                    continue;
+                }
+
+                std::string path = shared.names[nodes[n].rule];
+                for(std::size_t parent = nodes[n].parent; parent; parent = nodes[parent].parent){
+                    path = std::string(shared.names[nodes[parent].rule]) + ";" + path;
+                }
+
+                shared.stacks[path] += nodes[n].exclusive;
+            }
+
+            rules.assign(rules.size(), statistics());
+
+            for(auto& node : nodes){
+                node.exclusive = 0;
+            }
+        }
+};
+
+inline const char* profile_position(const char* it){
+    return it;
+}
+
+template<typename Base>
+const char* profile_position(const boost::spirit::classic::position_iterator2<Base>& it){
+    return profile_position(it.base());
+}
+
+// Profiles one call of a rule, a call left by an exception is a failure
+template<typename Iterator>
+class rule_probe {
+    public:
+        rule_probe(std::size_t rule, const Iterator& first) : profile(rule_profile::current()) {
+            profile.enter(rule, profile_position(first));
+        }
+
+        rule_probe(const rule_probe&) = delete;
+        rule_probe& operator=(const rule_probe&) = delete;
+
+        ~rule_probe(){
+            profile.exit(success, end);
+        }
+
+        void succeed(const Iterator& it){
+            success = true;
+            end = profile_position(it);
+        }
+
+    private:
+        rule_profile& profile;
+        bool success = false;
+        const char* end = nullptr;
+};
+
+} // end of grammar namespace
+
+#define MONSTER_PROBE_(rule_name)                                               \
+        static std::size_t const id = x3_grammar::rule_profile::rule_id(rule_name.name); \
+        x3_grammar::rule_probe<Iterator> probe(id, first);                      \
+    /***/
+
+#define MONSTER_SUCCEED_()                                                      \
+        if(result){                                                             \
+            probe.succeed(first);                                               \
+        }                                                                       \
+    /***/
+
+#else
+
+#define MONSTER_PROBE_(rule_name)
+#define MONSTER_SUCCEED_()
+
+#endif
+
+#define MONSTER_DEFINE_(r, data, rule_name)                                     \
+    template <typename Iterator, typename Context>                              \
+    inline bool parse_rule(                                                     \
+        decltype(rule_name) /* rule_ */                                         \
+      , Iterator& first, Iterator const& last                                   \
+      , Context const& context, decltype(rule_name)::attribute_type& attr)      \
+    {                                                                           \
+        static auto const def_ = (rule_name = BOOST_PP_CAT(rule_name, _def));   \
+        MONSTER_PROBE_(rule_name)                                               \
+        bool result = x3_grammar::parse_definition(def_, first, last, context, attr); \
+        MONSTER_SUCCEED_()                                                      \
+        return result;                                                          \
+    }                                                                           \
+    /***/
+
+#define MONSTER_DEFINE(...) BOOST_PP_SEQ_FOR_EACH(                              \
+    MONSTER_DEFINE_, _, BOOST_PP_VARIADIC_TO_SEQ(__VA_ARGS__))                  \
+    /***/
+
+#endif
+
+#endif
@@ -0,0 +1,237 @@
+#ifndef RECOVERY_HPP
+#define RECOVERY_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <boost/spirit/home/x3.hpp>
+
+#include "brace_scanner.hpp"
+#include "expect.hpp"
+#include "keyword.hpp"
+
+namespace x3 = boost::spirit::x3;
+
+/*
+ * Error recovery of the monster grammar.
+ *
+ * recover_list(p) parses a list of p like *p. While an error_recovery is
+ * active for the current thread (recovery_scope), an expectation failure in
+ * an element is recorded instead of aborting the parse, and the list
+ * resynchronizes after the next ';' or the next '}' closing a block of the
+ * element, or before the '}' closing the list or a top-level keyword at the
+ * beginning of a line. An element of a block starting with a top-level
+ * keyword ends the block (its '}' is missing). An element that fails to parse is an error as well,
+ * unless the list is at its end ('}' or, for the top-level blocks parsed
+ * with recover_top_level(p), the end of the input).
+ *
+ * The recovery is only done for const char* iterators. Without an active
+ * error_recovery, recover_list(p) is *p. The failures are caught with
+ * catch_expectation, with or without MONSTER_NO_EXCEPTIONS (see expect.hpp).
+ */
+
+namespace x3_grammar {
+
+class error_recovery {
+    public:
+        struct error {
+            const char* where;
+            std::string message;
+        };
+
+        std::vector<error> errors;
+
+        static error_recovery*& current(){
+            static thread_local error_recovery* recovery = nullptr;
+            return recovery;
+        }
+};
+
+class recovery_scope {
+    public:
+        explicit recovery_scope(error_recovery& recovery) : previous(error_recovery::current()) {
+            error_recovery::current() = &recovery;
+        }
+
+        recovery_scope(const recovery_scope&) = delete;
+        recovery_scope& operator=(const recovery_scope&) = delete;
+
+        ~recovery_scope(){
+            error_recovery::current() = previous;
+        }
+
+    private:
+        error_recovery* previous;
+};
+
+namespace recovery_detail {
+
+// Other iterators are not resynchronized
+template<typename Iterator>
+bool at_top_level_keyword(Iterator, Iterator const&){
+    return false;
+}
+
+inline bool at_top_level_keyword(const char* it, const char* last){
+    for(const char* keyword : {"import", "template", "struct"}){
+        std::size_t size = std::strlen(keyword);
+
+        if(static_cast<std::size_t>(last - it) >= size && std::equal(keyword, keyword + size, it) && keyword_detail::at_boundary(it + size, last)){
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template<typename Iterator>
+bool resync(Iterator&, Iterator const&, bool){
+    return false;
+}
+
+// Moves it to the next point where a list can continue
+inline bool resync(const char*& it, const char* last, bool top_level){
+    const char* next = last;
+    std::size_t depth = 0;
+
+    x3_grammar::scan_delimiters(it, last, [&](const char* delimiter){
+        if(*delimiter == '{'){
+            ++depth;
+            return true;
+        } else if(*delimiter == ';'){
+            if(depth == 0){
+                next = delimiter + 1;
+            }
+        } else if(depth == 0){
+            // The end of the list, an extra '}' at the top level
+            next = top_level ? delimiter + 1 : delimiter;
+        } else if(--depth == 0){
+            next = delimiter + 1;
+        }
+
+        return next == last;
+    });
+
+    // A missing '}' does not swallow the next top-level blocks
+    if(at_top_level_keyword(it, last)){
+        next = it;
+    } else {
+        for(const char* line = std::find(it, next, '\n'); line != next; line = std::find(line + 1, next, '\n')){
+            if(at_top_level_keyword(line + 1, last)){
+                next = line + 1;
+                break;
+            }
+        }
+    }
+
+    it = next;
+    return true;
+}
+
+} // end of recovery_detail namespace
+
+template<typename Subject, bool TopLevel>
+struct recover_list_parser : x3::unary_parser<Subject, recover_list_parser<Subject, TopLevel>> {
+    typedef x3::unary_parser<Subject, recover_list_parser<Subject, TopLevel>> base_type;
+    static bool const handles_container = true;
+
+    recover_list_parser(Subject const& subject) : base_type(subject) {}
+
+    template<typename Iterator, typename Context, typename RContext, typename Attribute>
+    bool parse(Iterator& first, Iterator const& last, Context const& context, RContext& rcontext, Attribute& attr) const {
+        auto* recovery = error_recovery::current();
+
+        if(!recovery){
+            while(x3::detail::parse_into_container(this->subject, first, last, context, rcontext, attr));
+            return true;
+        }
+
+        while(true){
+            Iterator start = first;
+
+            expectation_error<Iterator> failure;
+            bool parsed = catch_expectation(failure, [&]{ return x3::detail::parse_into_container(this->subject, first, last, context, rcontext, attr); });
+
+            if(failure){
+                // A block missing its '}' ends before the next top-level
+                // block, the enclosing rule reports the missing '}'
+                if(!TopLevel){
+                    Iterator element = start;
+                    x3::skip_over(element, last, context);
+
+                    if(recovery_detail::at_top_level_keyword(element, last)){
+                        first = start;
+                        break;
+                    }
+                }
+
+                Iterator next = failure.where;
+                if(!recovery_detail::resync(next, last, TopLevel)){
+                    return fail_expectation(failure);
+                }
+
+                recovery->errors.push_back({&*failure.where, "error: expected " + failure.which});
+                first = next;
+
+                // Stopped before the '}' closing the list
+                if(first == start){
+                    break;
+                }
+
+                continue;
+            }
+
+            if(parsed){
+                continue;
+            }
+
+            // The lists only end at the end of the input or before the '}' closing them
+            Iterator where = first;
+            x3::skip_over(where, last, context);
+
+            if(where == last || (!TopLevel && *where == '}')){
+                break;
+            }
+
+            Iterator next = where;
+            if(!recovery_detail::resync(next, last, TopLevel)){
+                break;
+            }
+
+            // A top-level keyword ends the list, unless it is the block that failed
+            if(next == where){
+                if(!TopLevel || !recovery_detail::resync(++next, last, TopLevel)){
+                    break;
+                }
+            }
+
+            recovery->errors.push_back({&*where, "error: unexpected input"});
+            first = next;
+        }
+
+        return true;
+    }
+};
+
+template<typename Subject>
+recover_list_parser<typename x3::extension::as_parser<Subject>::value_type, false> recover_list(Subject const& subject){
+    return {x3::as_parser(subject)};
+}
+
+template<typename Subject>
+recover_list_parser<typename x3::extension::as_parser<Subject>::value_type, true> recover_top_level(Subject const& subject){
+    return {x3::as_parser(subject)};
+}
+
+} // end of grammar namespace
+
+namespace boost { namespace spirit { namespace x3 { namespace traits {
+
+template<typename Subject, bool TopLevel, typename Context>
+struct attribute_of<x3_grammar::recover_list_parser<Subject, TopLevel>, Context> : build_container<typename attribute_of<Subject, Context>::type> {};
+
+}}}}
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef SKIPPER_HPP
+#define SKIPPER_HPP
+
+#include <boost/spirit/home/x3.hpp>
+
+namespace x3 = boost::spirit::x3;
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/*
+ * Skipper of the eddic grammar, equivalent to
+ *
+ *     x3::ascii::space
+ *   | ("/\*" >> *(x3::char_ - "*\/") >> "*\/")
+ *   | ("//" >> *(x3::char_ - (x3::eol | x3::eoi)) >> (x3::eol | x3::eoi))
+ *
+ * but skipping everything in one call instead of trying each alternative at
+ * each position. On const char* iterators, the runs of spaces and the ends of
+ * the comments are found with SSE2 block scans, or AVX2 ones when built with
+ * -mavx2 (make bench_skipper_avx2).
+ */
+
+namespace x3_grammar {
+
+namespace skipper_detail {
+
+inline bool is_space(char c){
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+template<typename Iterator>
+Iterator skip_spaces(Iterator it, Iterator last){
+    while(it != last && is_space(*it)){
+        ++it;
+    }
+
+    return it;
+}
+
+template<typename Iterator>
+Iterator find_line_end(Iterator it, Iterator last){
+    while(it != last && *it != '\n' && *it != '\r'){
+        ++it;
+    }
+
+    return it;
+}
+
+// Moves it after the end of the comment, returns false if it is not terminated
+template<typename Iterator>
+bool find_comment_end(Iterator& it, Iterator last){
+    while(it != last){
+        if(*it++ == '*' && it != last && *it == '/'){
+            ++it;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#ifdef __SSE2__
+
+// Mask of the bytes of the block that are spaces (' ' and '\t' to '\r')
+inline unsigned space_mask(__m128i block){
+    __m128i shifted = _mm_sub_epi8(block, _mm_set1_epi8('\t'));
+    __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8('\r' - '\t')), shifted);
+    __m128i space = _mm_cmpeq_epi8(block, _mm_set1_epi8(' '));
+
+    return _mm_movemask_epi8(_mm_or_si128(control, space));
+}
+
+inline unsigned line_end_mask(__m128i block){
+    __m128i n = _mm_cmpeq_epi8(block, _mm_set1_epi8('\n'));
+    __m128i r = _mm_cmpeq_epi8(block, _mm_set1_epi8('\r'));
+
+    return _mm_movemask_epi8(_mm_or_si128(n, r));
+}
+
+inline unsigned star_mask(__m128i block){
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8('*')));
+}
+
+#endif
+
+#ifdef __AVX2__
+
+inline unsigned space_mask(__m256i block){
+    __m256i shifted = _mm256_sub_epi8(block, _mm256_set1_epi8('\t'));
+    __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8('\r' - '\t')), shifted);
+    __m256i space = _mm256_cmpeq_epi8(block, _mm256_set1_epi8(' '));
+
+    return _mm256_movemask_epi8(_mm256_or_si256(control, space));
+}
+
+inline unsigned line_end_mask(__m256i block){
+    __m256i n = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n'));
+    __m256i r = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\r'));
+
+    return _mm256_movemask_epi8(_mm256_or_si256(n, r));
+}
+
+inline unsigned star_mask(__m256i block){
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('*')));
+}
+
+#endif
+
+inline const char* skip_spaces(const char* it, const char* last){
+#ifdef __AVX2__
+    for(; last - it >= 32; it += 32){
+        unsigned others = ~space_mask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(it)));
+
+        if(others){
+            return it + __builtin_ctz(others);
+        }
+    }
+#endif
+
+#ifdef __SSE2__
+    for(; last - it >= 16; it += 16){
+        unsigned others = ~space_mask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(it))) & 0xFFFF;
+
+        if(others){
+            return it + __builtin_ctz(others);
+        }
+    }
+#endif
+
+    return skip_spaces<const char*>(it, last);
+}
+
+inline const char* find_line_end(const char* it, const char* last){
+#ifdef __AVX2__
+    for(; last - it >= 32; it += 32){
+        if(unsigned mask = line_end_mask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(it)))){
+            return it + __builtin_ctz(mask);
+        }
+    }
+#endif
+
+#ifdef __SSE2__
+    for(; last - it >= 16; it += 16){
+        if(unsigned mask = line_end_mask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(it)))){
+            return it + __builtin_ctz(mask);
+        }
+    }
+#endif
+
+    return find_line_end<const char*>(it, last);
+}
+
+inline bool find_comment_end(const char*& it, const char* last){
+    // The character following a '*' may be after the block, hence the strict comparisons
+#ifdef __AVX2__
+    for(; last - it > 32; it += 32){
+        for(unsigned mask = star_mask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(it))); mask; mask &= mask - 1){
+            const char* star = it + __builtin_ctz(mask);
+
+            if(star[1] == '/'){
+                it = star + 2;
+                return true;
+            }
+        }
+    }
+#endif
+
+#ifdef __SSE2__
+    for(; last - it > 16; it += 16){
+        for(unsigned mask = star_mask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(it))); mask; mask &= mask - 1){
+            const char* star = it + __builtin_ctz(mask);
+
+            if(star[1] == '/'){
+                it = star + 2;
+                return true;
+            }
+        }
+    }
+#endif
+
+    return find_comment_end<const char*>(it, last);
+}
+
+} // end of skipper_detail namespace
+
+struct skipper_parser : x3::parser<skipper_parser> {
+    typedef x3::unused_type attribute_type;
+    static bool const has_attribute = false;
+
+    // Only succeeds if something has been skipped, X3 calls the skipper until it fails
+    template<typename Iterator, typename Context, typename RContext, typename Attribute>
+    bool parse(Iterator& first, Iterator const& last, Context const&, RContext&, Attribute&) const {
+        Iterator it = skip(first, last);
+
+        if(it == first){
+            return false;
+        }
+
+        first = it;
+        return true;
+    }
+
+    template<typename Iterator>
+    static Iterator skip(Iterator it, Iterator last){
+        using namespace skipper_detail;
+
+        while(true){
+            it = skip_spaces(it, last);
+
+            if(it == last || *it != '/'){
+                return it;
+            }
+
+            Iterator next = it;
+            if(++next == last){
+                return it;
+            }
+
+            if(*next == '/'){
+                it = find_line_end(++next, last);
+            } else if(*next == '*'){
+                // An unterminated comment is not skipped
+                if(!find_comment_end(++next, last)){
+                    return it;
+                }
+
+                it = next;
+            } else {
+                return it;
+            }
+        }
+    }
+};
+
+} // end of grammar namespace
+
+#endif
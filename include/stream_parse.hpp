@@ -0,0 +1,80 @@
+#ifndef STREAM_PARSE_HPP
+#define STREAM_PARSE_HPP
+
+#include <functional>
+#include <string>
+
+#include "monster.hpp"
+
+/*
+ * Streaming parse of eddic source, one top-level block at a time.
+ *
+ * The input is given in pieces of any size. Only the text up to the last ';'
+ * or '}' closing a top-level block is parsed, the rest waits for the next
+ * pieces. Each block is given to the callback and destroyed right after, so
+ * that the memory stays bounded by the largest block and not by the file.
+ *
+ * For the diagnostics, at most 4 KB of the current line are kept before the
+ * text not parsed yet. The line and the column are counted, but the source
+ * line of an error farther than that in a long line is truncated ("...").
+ *
+ * The views of the blocks point into the buffer of the parser, they are only
+ * valid during the callback.
+ */
+class stream_parser {
+    public:
+        typedef std::function<void(const x3_ast::block&)> block_callback;
+
+        stream_parser(block_callback callback, std::string file = "-") : callback(std::move(callback)), file(std::move(file)) {}
+
+        // Parses the blocks completed by data, returns false after an error
+        bool feed(const char* data, std::size_t size);
+
+        // Parses what is left at the end of the input
+        bool finish();
+
+        bool valid() const {
+            return diagnostic.empty();
+        }
+
+        // file:line:column: error, followed by the line and a caret, empty without error
+        const std::string& error() const {
+            return diagnostic;
+        }
+
+        std::size_t blocks() const {
+            return parsed_blocks;
+        }
+
+        // The largest size of the buffer
+        std::size_t peak_buffer() const {
+            return peak;
+        }
+
+    private:
+        block_callback callback;
+        std::string file;
+
+        // The last 4 KB at most of the current line (for the diagnostics), then the text not parsed yet
+        std::string buffer;
+        std::size_t line_prefix = 0;
+
+        // The position of the beginning of the buffer
+        std::size_t line = 1;
+        std::size_t column = 1;
+
+        // The buffer is only scanned again once it has doubled
+        std::size_t next_scan = 0;
+
+        std::size_t parsed_blocks = 0;
+        std::size_t peak = 0;
+        std::string diagnostic;
+
+        bool parse_until(const char* end);
+        void set_error(const char* where, const std::string& message);
+};
+
+// Parses the file (or the standard input with "-") with a stream_parser, reading it in pieces
+bool parse_stream(const std::string& path, stream_parser& parser);
+
+#endif
@@ -0,0 +1,194 @@
+#ifndef SYMBOL_HPP
+#define SYMBOL_HPP
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include <boost/spirit/home/x3.hpp>
+#include <boost/utility/string_view.hpp>
+
+#include "view.hpp"
+
+namespace x3 = boost::spirit::x3;
+
+/*
+ * Interned names.
+ *
+ * intern[p] parses p like view[p] and exposes the matched text as a 32-bit
+ * symbol of the global symbol_table, shared by all the parses of the program.
+ * Two symbols are equal if and only if their names are equal.
+ */
+
+namespace x3_ast {
+
+class symbol {
+    public:
+        symbol() = default;
+        explicit symbol(std::uint32_t id) : id(id) {}
+
+        std::uint32_t value() const {
+            return id;
+        }
+
+        bool empty() const {
+            return id == 0;
+        }
+
+        boost::string_view str() const;
+
+    private:
+        std::uint32_t id = 0;
+};
+
+inline bool operator==(symbol lhs, symbol rhs){
+    return lhs.value() == rhs.value();
+}
+
+inline bool operator!=(symbol lhs, symbol rhs){
+    return lhs.value() != rhs.value();
+}
+
+inline bool operator<(symbol lhs, symbol rhs){
+    return lhs.value() < rhs.value();
+}
+
+/*
+ * The table is split in shards, each one with its own lock, so that the
+ * threads parsing in parallel rarely wait for each other. The shard of a
+ * symbol is stored in the low bits of its id, 0 is the empty symbol.
+ */
+class symbol_table {
+    public:
+        symbol_table() = default;
+
+        symbol_table(const symbol_table&) = delete;
+        symbol_table& operator=(const symbol_table&) = delete;
+
+        symbol intern(boost::string_view name){
+            std::size_t h = hash(name);
+            auto& shard = shards[h % shards_count];
+
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            auto it = shard.ids.find(name);
+            if(it != shard.ids.end()){
+                return symbol(it->second);
+            }
+
+            // The deque never moves its strings, the keys can view them
+            shard.names.emplace_back(name.data(), name.size());
+
+            std::uint32_t id = static_cast<std::uint32_t>((shard.names.size() - 1) * shards_count + h % shards_count + 1);
+            shard.ids.emplace(boost::string_view(shard.names.back()), id);
+
+            return symbol(id);
+        }
+
+        boost::string_view name(symbol s){
+            if(s.empty()){
+                return {};
+            }
+
+            std::uint32_t index = s.value() - 1;
+            auto& shard = shards[index % shards_count];
+
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            return shard.names[index / shards_count];
+        }
+
+        std::size_t size(){
+            std::size_t result = 0;
+
+            for(auto& shard : shards){
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                result += shard.names.size();
+            }
+
+            return result;
+        }
+
+        static symbol_table& global(){
+            static symbol_table table;
+            return table;
+        }
+
+    private:
+        static const std::size_t shards_count = 16;
+
+        struct view_hash {
+            std::size_t operator()(boost::string_view name) const {
+                return hash(name);
+            }
+        };
+
+        struct shard {
+            std::mutex mutex;
+            std::deque<std::string> names;
+            std::unordered_map<boost::string_view, std::uint32_t, view_hash> ids;
+        };
+
+        shard shards[shards_count];
+
+        // FNV-1a
+        static std::size_t hash(boost::string_view name){
+            std::uint32_t h = 2166136261u;
+
+            for(char c : name){
+                h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+            }
+
+            return h;
+        }
+};
+
+inline boost::string_view symbol::str() const {
+    return symbol_table::global().name(*this);
+}
+
+inline std::ostream& operator<<(std::ostream& out, symbol s){
+    return out << s.str();
+}
+
+} //end of x3_ast namespace
+
+namespace x3_grammar {
+
+template<typename Subject>
+struct intern_directive : x3::unary_parser<Subject, intern_directive<Subject>> {
+    typedef x3::unary_parser<Subject, intern_directive<Subject>> base_type;
+    typedef x3_ast::symbol attribute_type;
+
+    static bool const handles_container = false;
+
+    intern_directive(Subject const& subject) : base_type(subject) {}
+
+    template<typename Iterator, typename Context, typename RContext, typename Attribute>
+    bool parse(Iterator& first, Iterator const& last, Context const& context, RContext& rcontext, Attribute& attr) const {
+        boost::string_view name;
+
+        if(!view_directive<Subject>(this->subject).parse(first, last, context, rcontext, name)){
+            return false;
+        }
+
+        x3::traits::move_to(x3_ast::symbol_table::global().intern(name), attr);
+
+        return true;
+    }
+};
+
+struct intern_gen {
+    template<typename Subject>
+    intern_directive<typename x3::extension::as_parser<Subject>::value_type> operator[](Subject const& subject) const {
+        return {x3::as_parser(subject)};
+    }
+};
+
+intern_gen const intern = intern_gen();
+
+} // end of grammar namespace
+
+#endif
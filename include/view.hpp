@@ -0,0 +1,74 @@
+#ifndef VIEW_HPP
+#define VIEW_HPP
+
+#include <iterator>
+
+#include <boost/spirit/home/x3.hpp>
+#include <boost/utility/string_view.hpp>
+
+namespace x3 = boost::spirit::x3;
+
+/*
+ * view[p] parses p and exposes the matched text as a boost::string_view
+ * into the input, instead of building a string char by char.
+ *
+ * The input must be contiguous (const char* or position_iterator2 on
+ * const char*) and outlive the views. Like x3::raw, the leading spaces are
+ * skipped before the view starts.
+ */
+
+namespace boost { namespace spirit { namespace x3 { namespace traits {
+
+// A view is set as a whole, not filled like a container of chars
+template<>
+struct attribute_category<boost::string_view> {
+    typedef plain_attribute type;
+};
+
+}}}}
+
+namespace x3_grammar {
+
+template<typename Subject>
+struct view_directive : x3::unary_parser<Subject, view_directive<Subject>> {
+    typedef x3::unary_parser<Subject, view_directive<Subject>> base_type;
+    typedef boost::string_view attribute_type;
+
+    static bool const handles_container = false;
+
+    view_directive(Subject const& subject) : base_type(subject) {}
+
+    template<typename Iterator, typename Context, typename RContext, typename Attribute>
+    bool parse(Iterator& first, Iterator const& last, Context const& context, RContext& rcontext, Attribute& attr) const {
+        x3::skip_over(first, last, context);
+
+        Iterator it = first;
+
+        if(!this->subject.parse(it, last, context, rcontext, x3::unused)){
+            return false;
+        }
+
+        boost::string_view view;
+        if(it != first){
+            view = boost::string_view(&*first, std::distance(first, it));
+        }
+
+        first = it;
+        x3::traits::move_to(view, attr);
+
+        return true;
+    }
+};
+
+struct view_gen {
+    template<typename Subject>
+    view_directive<typename x3::extension::as_parser<Subject>::value_type> operator[](Subject const& subject) const {
+        return {x3::as_parser(subject)};
+    }
+};
+
+view_gen const view = view_gen();
+
+} // end of grammar namespace
+
+#endif
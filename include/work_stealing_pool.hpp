@@ -0,0 +1,98 @@
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Runs a set of independent tasks on several threads.
+ *
+ * The tasks are first split in contiguous ranges, one per worker. A worker
+ * takes its tasks from the front of its own queue and, once it is empty,
+ * steals from the back of the queues of the other workers, so that a worker
+ * stuck on a large task does not delay the others. The calling thread is the
+ * first worker.
+ */
+class work_stealing_pool {
+    public:
+        explicit work_stealing_pool(std::size_t threads) : threads(threads ? threads : 1) {}
+
+        std::size_t size() const {
+            return threads;
+        }
+
+        // Calls task(worker, index) for each index in [0, tasks) and waits for all of them
+        template<typename Task>
+        void run(std::size_t tasks, Task task){
+            std::vector<std::unique_ptr<queue>> queues;
+
+            for(std::size_t worker = 0; worker < threads; ++worker){
+                queues.emplace_back(new queue());
+
+                for(std::size_t index = tasks * worker / threads; index < tasks * (worker + 1) / threads; ++index){
+                    queues.back()->tasks.push_back(index);
+                }
+            }
+
+            auto work = [&](std::size_t worker){
+                std::size_t index;
+
+                while(pop(*queues[worker], index) || steal(queues, worker, index)){
+                    task(worker, index);
+                }
+            };
+
+            std::vector<std::thread> workers;
+            for(std::size_t worker = 1; worker < threads; ++worker){
+                workers.emplace_back(work, worker);
+            }
+
+            work(0);
+
+            for(auto& thread : workers){
+                thread.join();
+            }
+        }
+
+    private:
+        struct queue {
+            std::mutex mutex;
+            std::deque<std::size_t> tasks;
+        };
+
+        std::size_t threads;
+
+        static bool pop(queue& queue, std::size_t& index){
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if(queue.tasks.empty()){
+                return false;
+            }
+
+            index = queue.tasks.front();
+            queue.tasks.pop_front();
+            return true;
+        }
+
+        // No task is ever added, so when all the queues are empty, the work is done
+        static bool steal(std::vector<std::unique_ptr<queue>>& queues, std::size_t worker, std::size_t& index){
+            for(std::size_t i = 1; i < queues.size(); ++i){
+                auto& victim = *queues[(worker + i) % queues.size()];
+
+                std::lock_guard<std::mutex> lock(victim.mutex);
+
+                if(!victim.tasks.empty()){
+                    index = victim.tasks.back();
+                    victim.tasks.pop_back();
+                    return true;
+                }
+            }
+
+            return false;
+        }
+};
+
+#endif
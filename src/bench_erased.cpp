@@ -0,0 +1,133 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "monster.hpp"
+#include "erased_parser.hpp"
+
+// The boundaries compiled in: 1 for the inlined parsers, 2 for any_parser, 4 for erased_parser
+#ifndef BENCH_BOUNDARIES
+#define BENCH_BOUNDARIES 7
+#endif
+
+namespace {
+
+typedef std::chrono::high_resolution_clock clock;
+
+// A parser small enough to be inlined in the loop
+auto const number = ('(' >> x3::int_ >> ')') | x3::int_;
+
+std::string numbers(std::size_t count){
+    std::string source;
+
+    for(std::size_t i = 0; i < count; ++i){
+        source += i % 2 ? "(" + std::to_string(i) + ") " : std::to_string(i) + " ";
+    }
+
+    return source;
+}
+
+std::string values(std::size_t count){
+    const char* samples[] = {"42", "3.5", "'c'", "\"text\"", "name", "7u"};
+
+    std::string source;
+
+    for(std::size_t i = 0; i < count; ++i){
+        source += samples[i % 6];
+        source += ' ';
+    }
+
+    return source;
+}
+
+template<typename Attribute, typename Parser>
+void bench(const std::string& name, const std::string& boundary, const std::string& source, const Parser& parser){
+    auto parse = [&](std::vector<Attribute>& result){
+        pos_iterator_type it = source.data();
+        pos_iterator_type end = source.data() + source.size();
+
+        return x3::phrase_parse(it, end, *parser, x3_grammar::skipper, result) && it == end;
+    };
+
+    std::vector<Attribute> result;
+    bool success = parse(result);
+    std::size_t elements = result.size();
+
+    // Repeat the parse until enough time has been spent for stable numbers
+    std::size_t iterations = 0;
+    auto start = clock::now();
+    auto elapsed = clock::duration::zero();
+    while(iterations == 0 || elapsed < std::chrono::milliseconds(500)){
+        result.clear();
+        parse(result);
+        ++iterations;
+        elapsed = clock::now() - start;
+    }
+
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations / elements;
+
+    // The grammars copy their subparsers, e.g. each *parser of a parse
+    const std::size_t copies = 1000000;
+
+    start = clock::now();
+    for(std::size_t i = 0; i < copies; ++i){
+        Parser copy(parser);
+
+        // Keeps the copy from being optimized away
+        asm volatile("" : : "r"(std::addressof(copy)) : "memory");
+    }
+    double copy_ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / copies;
+
+    std::cout
+        << std::left << std::setw(10) << name
+        << std::setw(16) << boundary
+        << std::right << std::setw(8) << (success ? "ok" : "failed")
+        << std::setw(10) << elements
+        << std::fixed << std::setprecision(2)
+        << std::setw(14) << ns
+        << std::setw(12) << copy_ns
+        << std::endl;
+}
+
+} // end of anonymous namespace
+
+int main(){
+    typedef x3_grammar::context_type context_type;
+
+    std::string number_source = numbers(100000);
+    std::string value_source = values(100000);
+
+    std::cout
+        << std::left << std::setw(10) << "parser"
+        << std::setw(16) << "boundary"
+        << std::right << std::setw(8) << "status"
+        << std::setw(10) << "elements"
+        << std::setw(14) << "ns/element"
+        << std::setw(12) << "ns/copy"
+        << std::endl;
+
+#if BENCH_BOUNDARIES & 1
+    bench<int>("number", "inlined", number_source, number);
+#endif
+#if BENCH_BOUNDARIES & 2
+    bench<int>("number", "any_parser", number_source, x3::any_parser<pos_iterator_type, int, context_type>(number));
+#endif
+#if BENCH_BOUNDARIES & 4
+    bench<int>("number", "erased_parser", number_source, x3_grammar::erased_parser<pos_iterator_type, int, context_type>(number));
+#endif
+
+#if BENCH_BOUNDARIES & 1
+    bench<x3_ast::value_t>("value", "rule", value_source, x3_grammar::value);
+#endif
+#if BENCH_BOUNDARIES & 2
+    bench<x3_ast::value_t>("value", "any_parser", value_source, x3::any_parser<pos_iterator_type, x3_ast::value_t, context_type>(x3_grammar::value));
+#endif
+#if BENCH_BOUNDARIES & 4
+    bench<x3_ast::value_t>("value", "erased_parser", value_source, x3_grammar::erased_parser<pos_iterator_type, x3_ast::value_t, context_type>(x3_grammar::value));
+#endif
+
+    return 0;
+}
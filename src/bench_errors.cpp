@@ -0,0 +1,183 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "monster.hpp"
+#include "eddic_generator.hpp"
+#include "expect.hpp"
+#include "recovery.hpp"
+
+// Built twice: bench_errors with the exceptions, bench_errors_noexcept with MONSTER_NO_EXCEPTIONS
+
+namespace {
+
+typedef std::chrono::high_resolution_clock clock;
+
+struct parse_result {
+    std::size_t failed = 0;
+    std::size_t errors = 0;
+};
+
+// Small files, as on a fuzzer, one per seed
+std::vector<std::string> make_files(std::size_t count, std::size_t size){
+    std::vector<std::string> files;
+
+    for(std::size_t i = 0; i < count; ++i){
+        generator_options options;
+        options.seed = i + 1;
+        options.size = size;
+
+        files.push_back(eddic_generator(options).generate());
+    }
+
+    return files;
+}
+
+// Removes a ';' or a ')' of each file, most of them are expectation points
+std::vector<std::string> remove_delimiter(std::vector<std::string> files){
+    std::mt19937 engine(42);
+
+    for(auto& file : files){
+        std::vector<std::size_t> delimiters;
+
+        for(std::size_t i = 0; i < file.size(); ++i){
+            if(file[i] == ';' || file[i] == ')'){
+                delimiters.push_back(i);
+            }
+        }
+
+        file.erase(delimiters[std::uniform_int_distribution<std::size_t>(0, delimiters.size() - 1)(engine)], 1);
+    }
+
+    return files;
+}
+
+// Cuts each file at a random position
+std::vector<std::string> truncate(std::vector<std::string> files){
+    std::mt19937 engine(42);
+
+    for(auto& file : files){
+        file.resize(std::uniform_int_distribution<std::size_t>(1, file.size() - 1)(engine));
+    }
+
+    return files;
+}
+
+// Removes every tenth ';' of each file
+std::vector<std::string> remove_semicolons(std::vector<std::string> files){
+    for(auto& file : files){
+        std::size_t semicolons = 0;
+
+        for(std::size_t i = 0; i < file.size(); ++i){
+            if(file[i] == ';' && ++semicolons % 10 == 0){
+                file.erase(i, 1);
+            }
+        }
+    }
+
+    return files;
+}
+
+parse_result parse_all(const std::vector<std::string>& files, bool recover){
+    parse_result result;
+
+    for(auto& file : files){
+        pos_iterator_type it = file.data();
+        pos_iterator_type end = file.data() + file.size();
+
+        x3_ast::arena arena;
+        x3_ast::arena_scope scope(arena);
+
+        x3_grammar::error_recovery recovery;
+        std::unique_ptr<x3_grammar::recovery_scope> recovery_scope(recover ? new x3_grammar::recovery_scope(recovery) : nullptr);
+
+        x3_ast::source_file ast;
+
+        x3_grammar::expectation_error<pos_iterator_type> failure;
+        bool success = x3_grammar::catch_expectation(failure, [&]{ return x3::phrase_parse(it, end, x3_grammar::parser, x3_grammar::skipper, ast); });
+
+        std::size_t errors = recovery.errors.size() + (failure ? 1 : 0);
+        if(!errors && (!success || it != end)){
+            errors = 1;
+        }
+
+        result.failed += errors ? 1 : 0;
+        result.errors += errors;
+    }
+
+    return result;
+}
+
+void bench(const std::string& name, const std::vector<std::string>& files, bool recover){
+    parse_result result = parse_all(files, recover);
+
+    // Repeat the parse until enough time has been spent for stable numbers
+    std::size_t iterations = 0;
+    auto start = clock::now();
+    auto elapsed = clock::duration::zero();
+    while(iterations == 0 || elapsed < std::chrono::milliseconds(500)){
+        parse_all(files, recover);
+        ++iterations;
+        elapsed = clock::now() - start;
+    }
+
+    double seconds = std::chrono::duration<double>(elapsed).count() / iterations;
+
+    std::size_t bytes = 0;
+    for(auto& file : files){
+        bytes += file.size();
+    }
+
+    std::cout
+        << std::left << std::setw(20) << name
+        << std::setw(10) << (recover ? "recover" : "first")
+        << std::right << std::setw(8) << files.size()
+        << std::setw(8) << result.failed
+        << std::setw(8) << result.errors
+        << std::fixed << std::setprecision(2)
+        << std::setw(12) << seconds * 1e6 / files.size()
+        << std::setw(12) << (bytes / (1024.0 * 1024.0)) / seconds
+        << std::endl;
+}
+
+} // end of anonymous namespace
+
+int main(){
+#ifdef MONSTER_NO_EXCEPTIONS
+    std::cout << "expectations: error state" << std::endl;
+#else
+    std::cout << "expectations: exceptions" << std::endl;
+#endif
+
+    std::cout
+        << std::left << std::setw(20) << "input"
+        << std::setw(10) << "mode"
+        << std::right << std::setw(8) << "files"
+        << std::setw(8) << "failed"
+        << std::setw(8) << "errors"
+        << std::setw(12) << "us/file"
+        << std::setw(12) << "MB/s"
+        << std::endl;
+
+    auto files = make_files(256, 4 * 1024);
+
+    bench("valid", files, false);
+
+    auto removed = remove_delimiter(files);
+    bench("missing delimiter", removed, false);
+    bench("missing delimiter", removed, true);
+
+    auto truncated = truncate(files);
+    bench("truncated", truncated, false);
+    bench("truncated", truncated, true);
+
+    auto semicolons = remove_semicolons(files);
+    bench("missing ';'", semicolons, false);
+    bench("missing ';'", semicolons, true);
+
+    return 0;
+}
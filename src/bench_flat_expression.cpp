@@ -0,0 +1,99 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "problem_8.hpp"
+
+namespace {
+
+typedef std::chrono::high_resolution_clock clock;
+
+// The time of one call of f, repeated until enough time has been spent for stable numbers
+template<typename F>
+double time_ns(F f){
+    std::size_t iterations = 0;
+    auto start = clock::now();
+    auto elapsed = clock::duration::zero();
+    while(iterations == 0 || elapsed < std::chrono::milliseconds(500)){
+        f();
+        ++iterations;
+        elapsed = clock::now() - start;
+    }
+
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+// operands joined by the operators of all the levels, with or without parentheses
+std::string make_expression(std::size_t operands, bool parentheses){
+    const char* operators[] = {" + ", " * ", " - ", " / ", " < ", " && ", " % ", " || "};
+
+    std::string source;
+    for(std::size_t i = 0; i < operands; ++i){
+        if(i){
+            source += operators[(i * 7) % 8];
+        }
+
+        if(parentheses && i % 5 == 0){
+            source += "(";
+        }
+
+        source += "x";
+
+        if(parentheses && i % 5 == 3){
+            source += ")";
+        }
+    }
+
+    return source;
+}
+
+void bench(const std::string& name, const std::string& source){
+    auto it = source.begin();
+    auto end = source.end();
+
+    x3_ast::value tree;
+    bool success = x3::phrase_parse(it, end, x3_grammar::value, x3::ascii::space, tree) && it == end;
+
+    x3_ast::flat_value flat;
+    flat.flatten(tree);
+
+    success = success && operand_counter()(tree) == operand_counter()(flat.root());
+
+    volatile std::size_t operands = 0;
+    double walk_tree = time_ns([&]{ operands = operand_counter()(tree); });
+    double walk_flat = time_ns([&]{ operands = operand_counter()(flat.root()); });
+    double flatten = time_ns([&]{ flat.flatten(tree); });
+
+    double nodes = flat.nodes();
+
+    std::cout
+        << std::left << std::setw(16) << name
+        << std::right << std::setw(8) << (success ? "ok" : "failed")
+        << std::setw(10) << flat.nodes()
+        << std::fixed << std::setprecision(2)
+        << std::setw(12) << walk_tree / nodes
+        << std::setw(12) << walk_flat / nodes
+        << std::setw(12) << flatten / nodes
+        << std::endl;
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv){
+    std::size_t operands = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+    std::cout
+        << std::left << std::setw(16) << "expression"
+        << std::right << std::setw(8) << "status"
+        << std::setw(10) << "nodes"
+        << std::setw(12) << "tree ns"
+        << std::setw(12) << "flat ns"
+        << std::setw(12) << "flatten ns"
+        << std::endl;
+
+    bench("chain", make_expression(operands, false));
+    bench("parentheses", make_expression(operands, true));
+
+    return 0;
+}
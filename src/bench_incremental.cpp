@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "incremental.hpp"
+#include "eddic_generator.hpp"
+
+namespace {
+
+typedef std::chrono::high_resolution_clock clock;
+
+struct latencies {
+    std::vector<double> values;
+
+    void print(const std::string& name) const {
+        auto sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+
+        double total = 0.0;
+        for(double value : sorted){
+            total += value;
+        }
+
+        std::cout
+            << std::left << std::setw(20) << name
+            << std::right << std::setw(8) << sorted.size()
+            << std::fixed << std::setprecision(1)
+            << std::setw(12) << total / sorted.size()
+            << std::setw(12) << sorted[sorted.size() / 2]
+            << std::setw(12) << sorted[sorted.size() * 99 / 100]
+            << std::setw(12) << sorted.back()
+            << std::endl;
+    }
+};
+
+template<typename Edit>
+double time_us(Edit edit){
+    auto start = clock::now();
+    edit();
+    return std::chrono::duration<double, std::micro>(clock::now() - start).count();
+}
+
+bool same_as_full_parse(const incremental_source& source){
+    incremental_source full;
+    bool valid = full.parse(source.text());
+
+    if(!valid){
+        return !source.valid();
+    }
+
+    return source.valid() && full.ast().blocks.size() == source.ast().blocks.size() && full.block_offsets() == source.block_offsets();
+}
+
+// Edits at the boundaries of the top-level blocks, joining a block to the one
+// before it or deleting across the '}' that ends it, each one undone afterwards
+bool same_as_full_parse_boundaries(incremental_source& source, std::mt19937& generator){
+    const std::string original = source.text();
+
+    bool consistent = true;
+
+    for(std::size_t i = 0; i < 50; ++i){
+        auto offsets = source.block_offsets();
+        std::size_t offset = offsets[1 + generator() % (offsets.size() - 1)];
+
+        std::string text = source.text();
+        std::size_t first = text.find_first_not_of(" \t\r\n", offset);
+
+        std::string inserted;
+        if(text.compare(first, 7, "struct ") == 0){
+            inserted = "template<type S>\n";
+        } else if(text.compare(first, 8, "template") == 0){
+            inserted = "struct Added {\n}\n\n";
+        } else {
+            inserted = "const ";
+        }
+
+        source.edit(offset, 0, inserted);
+        consistent = consistent && same_as_full_parse(source);
+
+        source.edit(offset, inserted.size(), "");
+        consistent = consistent && same_as_full_parse(source);
+
+        // Not after a global variable
+        std::size_t brace = text.find_last_not_of(" \t\r\n", offset - 1);
+        if(text[brace] == '}'){
+            std::string removed = text.substr(brace, first + 1 - brace);
+
+            source.edit(brace, removed.size(), "");
+            consistent = consistent && same_as_full_parse(source);
+
+            source.edit(brace, 0, removed);
+            consistent = consistent && same_as_full_parse(source);
+        }
+    }
+
+    return consistent && source.text() == original;
+}
+
+// A block comment opened in a block and closed in another, in both orders, the
+// source being invalid in between
+bool same_as_full_parse_comments(){
+    const std::string text = "void a(){}\nvoid b(){}\nvoid c(){}\nvoid d(){}\n";
+
+    bool consistent = true;
+
+    for(bool open_first : {true, false}){
+        incremental_source source;
+        source.parse(text);
+
+        if(open_first){
+            source.edit(text.find("void b"), 0, "/*");
+            consistent = consistent && !source.valid();
+            source.edit(source.text().find("void d"), 0, "*/ ");
+        } else {
+            source.edit(text.find("void d"), 0, "*/ ");
+            consistent = consistent && !source.valid();
+            source.edit(text.find("void b"), 0, "/*");
+        }
+
+        consistent = consistent && source.valid() && same_as_full_parse(source) && source.ast().blocks.size() == 2;
+    }
+
+    return consistent;
+}
+
+} // end of anonymous namespace
+
+int main(){
+    generator_options options;
+    options.size = 1500 * 1024;
+
+    std::string text = eddic_generator(options).generate();
+
+    // Typing happens at the beginning of the instruction lists (not of the structures)
+    std::vector<std::size_t> positions;
+    for(std::size_t position = text.find("){\n"); position != std::string::npos; position = text.find("){\n", position + 1)){
+        positions.push_back(position + 3);
+    }
+
+    incremental_source source;
+
+    auto start = clock::now();
+    bool valid = source.parse(text);
+    double full = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+
+    std::cout << std::count(text.begin(), text.end(), '\n') << " lines, " << text.size() << " bytes, " << source.block_offsets().size() << " blocks" << std::endl;
+    std::cout << "full parse " << (valid ? "ok" : "failed") << " in " << std::fixed << std::setprecision(1) << full << " us" << std::endl;
+    std::cout << std::endl;
+
+    std::cout
+        << std::left << std::setw(20) << "edit (us)"
+        << std::right << std::setw(8) << "count"
+        << std::setw(12) << "mean"
+        << std::setw(12) << "median"
+        << std::setw(12) << "p99"
+        << std::setw(12) << "max"
+        << std::endl;
+
+    const std::string statement = "        int added = 1;\n";
+
+    std::mt19937 generator(42);
+
+    latencies typing;
+    latencies erasing;
+    latencies pasting;
+
+    bool consistent = true;
+
+    for(std::size_t i = 0; i < 50; ++i){
+        std::size_t position = positions[generator() % positions.size()];
+
+        // One keystroke after another, the intermediate states are invalid
+        for(std::size_t c = 0; c < statement.size(); ++c){
+            typing.values.push_back(time_us([&]{ source.edit(position + c, 0, statement.substr(c, 1)); }));
+        }
+
+        consistent = consistent && source.valid() && same_as_full_parse(source);
+
+        for(std::size_t c = statement.size(); c > 0; --c){
+            erasing.values.push_back(time_us([&]{ source.edit(position + c - 1, 1, ""); }));
+        }
+
+        pasting.values.push_back(time_us([&]{ source.edit(position, 0, statement); }));
+        pasting.values.push_back(time_us([&]{ source.edit(position, statement.size(), ""); }));
+    }
+
+    typing.print("typing");
+    erasing.print("erasing");
+    pasting.print("paste and undo");
+
+    std::cout << std::endl;
+    consistent = consistent && source.text() == text && same_as_full_parse(source);
+    consistent = consistent && same_as_full_parse_boundaries(source, generator) && same_as_full_parse_comments();
+
+    std::cout << "consistent with full parses: " << (consistent ? "yes" : "no") << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,295 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/fusion/include/for_each.hpp>
+#include <boost/fusion/include/is_sequence.hpp>
+
+#include "monster.hpp"
+#include "ast_cache.hpp"
+#include "eddic_generator.hpp"
+#include "memo.hpp"
+
+// Every allocation of the program goes through this counter
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size){
+    ++allocations;
+
+    if(void* p = std::malloc(size ? size : 1)){
+        return p;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+struct node_counter {
+    std::size_t nodes = 0;
+
+    typedef void result_type;
+
+    template<typename T>
+    void operator()(const T& value){
+        count(value);
+    }
+
+    template<typename T>
+    typename std::enable_if<!boost::fusion::traits::is_sequence<T>::value>::type count(const T&){
+        //Leaves (strings, numbers) are not nodes
+    }
+
+    template<typename T>
+    typename std::enable_if<boost::fusion::traits::is_sequence<T>::value>::type count(const T& value){
+        ++nodes;
+        boost::fusion::for_each(value, [this](const auto& member){ this->count(member); });
+    }
+
+    template<typename T, typename Allocator>
+    void count(const std::vector<T, Allocator>& values){
+        for(auto& value : values){
+            count(value);
+        }
+    }
+
+    template<typename T>
+    void count(const boost::optional<T>& value){
+        if(value){
+            count(*value);
+        }
+    }
+
+    template<typename T>
+    void count(const x3::forward_ast<T>& value){
+        count(value.get());
+    }
+
+    template<typename... T>
+    void count(const x3::variant<T...>& value){
+        boost::apply_visitor(*this, value);
+    }
+};
+
+std::string make_corpus(std::size_t size){
+    generator_options options;
+    options.size = size;
+
+    return eddic_generator(options).generate();
+}
+
+std::string read_file(const std::string& file){
+    std::ifstream in(file.c_str(), std::ios::binary);
+
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+struct parse_result {
+    bool success;
+    std::size_t allocations;
+    std::size_t nodes;
+};
+
+enum class parse_mode {
+    plain,
+    memo,
+    arena,
+    memo_arena,
+    cached
+};
+
+// Memoization table of the memo runs, cleared by each memo_scope and kept by
+// the other modes for the report
+x3_grammar::memo_table memo_table;
+
+// The serialized AST of the input of the cached runs
+std::string cached_ast;
+
+template<typename Iterator>
+bool parse_into(Iterator it, Iterator end, x3_ast::source_file& result){
+    bool r = x3::phrase_parse(it, end, x3_grammar::parser, x3_grammar::skipper, result);
+    return r && it == end;
+}
+
+template<typename Iterator>
+parse_result parse_once(Iterator it, Iterator end, parse_mode mode){
+    parse_result stats;
+    node_counter counter;
+
+    std::size_t before = allocations;
+
+    if(mode == parse_mode::arena || mode == parse_mode::memo_arena){
+        x3_ast::arena arena;
+        x3_ast::arena_scope scope(arena);
+
+        // Never destroyed, the whole tree is freed at once with the arena
+        auto* result = new (arena.allocate(sizeof(x3_ast::source_file))) x3_ast::source_file();
+
+        // The memo_scope ends before the arena, with the entries allocated in it
+        if(mode == parse_mode::memo_arena){
+            x3_grammar::memo_scope memo_scope(memo_table);
+            stats.success = parse_into(it, end, *result);
+        } else {
+            stats.success = parse_into(it, end, *result);
+        }
+
+        stats.allocations = allocations - before;
+
+        counter.count(*result);
+    } else {
+        x3_ast::source_file result;
+
+        if(mode == parse_mode::memo){
+            x3_grammar::memo_scope scope(memo_table);
+            stats.success = parse_into(it, end, result);
+        } else {
+            stats.success = parse_into(it, end, result);
+        }
+
+        stats.allocations = allocations - before;
+
+        counter.count(result);
+    }
+
+    stats.nodes = counter.nodes;
+
+    return stats;
+}
+
+// Loads the AST from its serialized form into an arena instead of parsing it
+parse_result load_once(std::string& contents){
+    parse_result stats;
+    node_counter counter;
+
+    std::size_t before = allocations;
+
+    x3_ast::arena arena;
+    x3_ast::arena_scope scope(arena);
+
+    auto* result = new (arena.allocate(sizeof(x3_ast::source_file))) x3_ast::source_file();
+
+    stats.success = x3_ast::deserialize(cached_ast.data(), cached_ast.size(), contents.data(), contents.data() + contents.size(), *result);
+    stats.allocations = allocations - before;
+
+    counter.count(*result);
+    stats.nodes = counter.nodes;
+
+    return stats;
+}
+
+parse_result parse_with(std::string& contents, pos_iterator_type*, parse_mode mode){
+    if(mode == parse_mode::cached){
+        return load_once(contents);
+    }
+
+    return parse_once(contents.data(), contents.data() + contents.size(), mode);
+}
+
+parse_result parse_with(std::string& contents, position_iterator_type*, parse_mode mode){
+    return parse_once(position_iterator_type(contents.data(), contents.data() + contents.size(), "corpus"), position_iterator_type(), mode);
+}
+
+template<typename Iterator>
+void bench(const std::string& name, const std::string& iterator_name, std::string& contents, parse_mode mode){
+    typedef std::chrono::high_resolution_clock clock;
+
+    parse_result stats = parse_with(contents, static_cast<Iterator*>(nullptr), mode);
+
+    // Repeat the parse until enough time has been spent for stable numbers
+    std::size_t iterations = 0;
+    auto start = clock::now();
+    auto elapsed = clock::duration::zero();
+    while(iterations == 0 || elapsed < std::chrono::milliseconds(500)){
+        parse_with(contents, static_cast<Iterator*>(nullptr), mode);
+        ++iterations;
+        elapsed = clock::now() - start;
+    }
+
+    double seconds = std::chrono::duration<double>(elapsed).count() / iterations;
+    double bytes = contents.size();
+
+    std::cout
+        << std::left << std::setw(24) << name
+        << std::setw(24) << iterator_name
+        << std::right << std::setw(8) << (stats.success ? "ok" : "failed")
+        << std::fixed << std::setprecision(2)
+        << std::setw(12) << (bytes / (1024.0 * 1024.0)) / seconds
+        << std::setw(12) << (seconds * 1e9) / bytes
+        << std::setw(14) << stats.allocations / (bytes / 1024.0)
+        << std::setw(12) << stats.nodes
+        << std::endl;
+}
+
+void bench(const std::string& name, std::string& contents){
+    bench<pos_iterator_type>(name, "const char*", contents, parse_mode::plain);
+    bench<position_iterator_type>(name, "position_iterator", contents, parse_mode::plain);
+    bench<pos_iterator_type>(name, "const char* memo", contents, parse_mode::memo);
+    bench<pos_iterator_type>(name, "const char* arena", contents, parse_mode::arena);
+    bench<pos_iterator_type>(name, "const char* memo arena", contents, parse_mode::memo_arena);
+
+    x3_ast::source_file ast;
+    if(parse_into(contents.data(), contents.data() + contents.size(), ast) && x3_ast::serialize(contents.data(), contents.data() + contents.size(), ast, cached_ast)){
+        bench<pos_iterator_type>(name, "const char* cache", contents, parse_mode::cached);
+    }
+
+    std::cout << std::endl;
+    memo_table.report(std::cout);
+    std::cout << std::endl;
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv){
+    std::size_t max_size = 100 * 1024 * 1024;
+    std::vector<std::string> files;
+
+    for(int i = 1; i < argc; ++i){
+        std::string arg(argv[i]);
+
+        if(arg.find_first_not_of("0123456789") == std::string::npos){
+            max_size = std::stoul(arg);
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    std::cout
+        << std::left << std::setw(24) << "input"
+        << std::setw(24) << "iterator"
+        << std::right << std::setw(8) << "status"
+        << std::setw(12) << "MB/s"
+        << std::setw(12) << "ns/byte"
+        << std::setw(14) << "allocs/KB"
+        << std::setw(12) << "nodes"
+        << std::endl;
+
+    if(files.empty()){
+        for(std::size_t size = 1024; size <= max_size; size *= 10){
+            std::string contents = make_corpus(size);
+            bench(std::to_string(contents.size()) + " bytes", contents);
+        }
+    } else {
+        for(auto& file : files){
+            std::string contents = read_file(file);
+            bench(file, contents);
+        }
+    }
+
+    return 0;
+}
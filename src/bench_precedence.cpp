@@ -0,0 +1,195 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include "problem_8.hpp"
+
+// Every allocation of the program goes through this counter
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size){
+    ++allocations;
+
+    if(void* p = std::malloc(size ? size : 1)){
+        return p;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+// The same operators with one rule per level of precedence, as before x3_grammar::precedence
+namespace per_level {
+
+    x3::rule<struct or_class, x3_ast::expression> const or_expression("or_expression");
+    x3::rule<struct and_class, x3_ast::expression> const and_expression("and_expression");
+    x3::rule<struct equality_class, x3_ast::expression> const equality_expression("equality_expression");
+    x3::rule<struct relational_class, x3_ast::expression> const relational_expression("relational_expression");
+    x3::rule<struct additive_class, x3_ast::expression> const additive_expression("additive_expression");
+    x3::rule<struct multiplicative_class, x3_ast::expression> const multiplicative_expression("multiplicative_expression");
+
+    // The operands of the operations are values
+    x3::rule<struct and_value_class, x3_ast::value> const and_value("and_value");
+    x3::rule<struct equality_value_class, x3_ast::value> const equality_value("equality_value");
+    x3::rule<struct relational_value_class, x3_ast::value> const relational_value("relational_value");
+    x3::rule<struct additive_value_class, x3_ast::value> const additive_value("additive_value");
+    x3::rule<struct multiplicative_value_class, x3_ast::value> const multiplicative_value("multiplicative_value");
+
+    x3::rule<struct cast_class, x3_ast::value> const cast_expression("cast_expression");
+    x3::rule<struct value_class, x3_ast::value> const value("value");
+
+    x3::rule<struct or_operation_class, x3_ast::operation> const or_operation("or_operation");
+    x3::rule<struct and_operation_class, x3_ast::operation> const and_operation("and_operation");
+    x3::rule<struct equality_operation_class, x3_ast::operation> const equality_operation("equality_operation");
+    x3::rule<struct relational_operation_class, x3_ast::operation> const relational_operation("relational_operation");
+    x3::rule<struct additive_operation_class, x3_ast::operation> const additive_operation("additive_operation");
+    x3::rule<struct multiplicative_operation_class, x3_ast::operation> const multiplicative_operation("multiplicative_operation");
+
+    auto const value_def = or_expression;
+
+    auto const or_expression_def = and_expression >> *or_operation;
+    auto const and_expression_def = equality_expression >> *and_operation;
+    auto const equality_expression_def = relational_expression >> *equality_operation;
+    auto const relational_expression_def = additive_expression >> *relational_operation;
+    auto const additive_expression_def = multiplicative_expression >> *additive_operation;
+    auto const multiplicative_expression_def = cast_expression >> *multiplicative_operation;
+
+    auto const and_value_def = and_expression;
+    auto const equality_value_def = equality_expression;
+    auto const relational_value_def = relational_expression;
+    auto const additive_value_def = additive_expression;
+    auto const multiplicative_value_def = multiplicative_expression;
+
+    auto const or_operation_def =
+            (x3::lit("||") >> x3::attr(x3_ast::Operator::OR))
+        >   and_value;
+
+    auto const and_operation_def =
+            (x3::lit("&&") >> x3::attr(x3_ast::Operator::AND))
+        >   equality_value;
+
+    auto const equality_operation_def =
+            (   (x3::lit("==") >> x3::attr(x3_ast::Operator::EQUALS))
+            |   (x3::lit("!=") >> x3::attr(x3_ast::Operator::NOT_EQUALS)))
+        >   relational_value;
+
+    auto const relational_operation_def =
+            (   (x3::lit("<=") >> x3::attr(x3_ast::Operator::LESS_EQUALS))
+            |   (x3::lit('<') >> x3::attr(x3_ast::Operator::LESS))
+            |   (x3::lit(">=") >> x3::attr(x3_ast::Operator::GREATER_EQUALS))
+            |   (x3::lit('>') >> x3::attr(x3_ast::Operator::GREATER)))
+        >   additive_value;
+
+    auto const additive_operation_def =
+            (   (x3::lit('+') >> x3::attr(x3_ast::Operator::ADD))
+            |   (x3::lit('-') >> x3::attr(x3_ast::Operator::SUB)))
+        >   multiplicative_value;
+
+    auto const multiplicative_operation_def =
+            (   (x3::lit('*') >> x3::attr(x3_ast::Operator::MUL))
+            |   (x3::lit('/') >> x3::attr(x3_ast::Operator::DIV))
+            |   (x3::lit('%') >> x3::attr(x3_ast::Operator::MOD)))
+        >   cast_expression;
+
+    auto const cast_expression_def =
+            x3_grammar::variable_value
+        |   ('(' > value > ')');
+
+    BOOST_SPIRIT_DEFINE(
+        value,
+        or_expression, and_expression, equality_expression, relational_expression, additive_expression, multiplicative_expression,
+        and_value, equality_value, relational_value, additive_value, multiplicative_value,
+        or_operation, and_operation, equality_operation, relational_operation, additive_operation, multiplicative_operation,
+        cast_expression
+    );
+
+} // end of per_level namespace
+
+namespace {
+
+typedef std::chrono::high_resolution_clock clock;
+
+template<typename Parser>
+bool parse(const std::string& source, const Parser& parser){
+    auto it = source.begin();
+    auto end = source.end();
+
+    x3_ast::value result;
+    bool r = x3::phrase_parse(it, end, parser, x3::ascii::space, result);
+
+    return r && it == end;
+}
+
+template<typename Parser>
+void bench(const std::string& input, const std::string& grammar, const std::string& source, const Parser& parser){
+    bool success = parse(source, parser);
+
+    // Repeat the parse until enough time has been spent for stable numbers
+    std::size_t before = allocations;
+    std::size_t iterations = 0;
+    auto start = clock::now();
+    auto elapsed = clock::duration::zero();
+    while(iterations == 0 || elapsed < std::chrono::milliseconds(500)){
+        parse(source, parser);
+        ++iterations;
+        elapsed = clock::now() - start;
+    }
+
+    std::cout
+        << std::left << std::setw(16) << input
+        << std::setw(12) << grammar
+        << std::right << std::setw(8) << (success ? "ok" : "failed")
+        << std::fixed << std::setprecision(2)
+        << std::setw(14) << std::chrono::duration<double, std::micro>(elapsed).count() / iterations
+        << std::setw(14) << static_cast<double>(allocations - before) / iterations
+        << std::endl;
+}
+
+} // end of anonymous namespace
+
+int main(){
+    std::cout
+        << std::left << std::setw(16) << "input"
+        << std::setw(12) << "grammar"
+        << std::right << std::setw(8) << "status"
+        << std::setw(14) << "us/parse"
+        << std::setw(14) << "allocs/parse"
+        << std::endl;
+
+    std::string identifier = "abc";
+
+    // 200 operands of the same level
+    std::string chain;
+    for(std::size_t i = 0; i < 200; ++i){
+        chain += (i ? " + v" : "v") + std::to_string(i);
+    }
+
+    // 200 operands of all the levels, with some parentheses
+    const char* operators[] = {" + ", " * ", " - ", " / ", " < ", " && ", " % ", " || "};
+
+    std::string mixed;
+    for(std::size_t i = 0; i < 200; ++i){
+        if(i){
+            mixed += operators[i % 8];
+        }
+
+        mixed += i % 10 == 0 ? "(a + b)" : "x";
+    }
+
+    for(auto& input : {std::make_pair("identifier", &identifier), std::make_pair("chain", &chain), std::make_pair("mixed", &mixed)}){
+        bench(input.first, "per level", *input.second, per_level::value);
+        bench(input.first, "precedence", *input.second, x3_grammar::value);
+    }
+
+    return 0;
+}
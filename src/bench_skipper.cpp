@@ -0,0 +1,107 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "eddic_generator.hpp"
+#include "skipper.hpp"
+
+namespace {
+
+// The previous skipper of the monster grammar
+auto const classic_skipper =
+        x3::ascii::space
+    |   ("/*" >> *(x3::char_ - "*/") >> "*/")
+    |   ("//" >> *(x3::char_ - (x3::eol | x3::eoi)) >> (x3::eol | x3::eoi));
+
+x3_grammar::skipper_parser const fast_skipper{};
+
+// Keeps the compiler from optimizing the tokenization away
+volatile std::size_t sink;
+
+bool is_token_end(char c){
+    return c == ' ' || (c >= '\t' && c <= '\r') || c == '/';
+}
+
+/*
+ * Go through the source the way a parser does: skip, then consume a token
+ * (everything up to the next space or '/'), until the end. Returns the sum of
+ * the positions of the tokens, to check the skippers agree with each other.
+ */
+template<typename Skipper>
+std::size_t tokenize(const std::string& source, const Skipper& skipper){
+    const char* first = source.data();
+    const char* it = first;
+    const char* last = first + source.size();
+
+    std::size_t checksum = 0;
+
+    while(it != last){
+        x3::skip_over(it, last, x3::make_context<x3::skipper_tag>(skipper));
+
+        if(it == last){
+            break;
+        }
+
+        checksum += it - first;
+
+        do {
+            ++it;
+        } while(it != last && !is_token_end(*it));
+    }
+
+    return checksum;
+}
+
+template<typename Skipper>
+double bench(const std::string& source, const Skipper& skipper){
+    typedef std::chrono::high_resolution_clock clock;
+
+    std::size_t iterations = 0;
+    auto start = clock::now();
+    auto elapsed = clock::duration::zero();
+    while(iterations == 0 || elapsed < std::chrono::milliseconds(500)){
+        sink = tokenize(source, skipper);
+        ++iterations;
+        elapsed = clock::now() - start;
+    }
+
+    double seconds = std::chrono::duration<double>(elapsed).count() / iterations;
+    return (source.size() / (1024.0 * 1024.0)) / seconds;
+}
+
+} // end of anonymous namespace
+
+int main(){
+    std::cout
+        << std::left << std::setw(12) << "comments"
+        << std::right << std::setw(14) << "classic MB/s"
+        << std::setw(14) << "fast MB/s"
+        << std::setw(10) << "speedup"
+        << std::setw(10) << "check"
+        << std::endl;
+
+    for(unsigned comments : {0, 10, 50, 100}){
+        generator_options options;
+        options.size = 4 * 1024 * 1024;
+        options.mix["comment"] = comments;
+
+        std::string source = eddic_generator(options).generate();
+
+        bool same = tokenize(source, classic_skipper) == tokenize(source, fast_skipper);
+
+        double classic = bench(source, classic_skipper);
+        double fast = bench(source, fast_skipper);
+
+        std::cout
+            << std::left << std::setw(12) << (std::to_string(comments) + "%")
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(14) << classic
+            << std::setw(14) << fast
+            << std::setw(9) << fast / classic << "x"
+            << std::setw(10) << (same ? "ok" : "MISMATCH")
+            << std::endl;
+    }
+
+    return 0;
+}
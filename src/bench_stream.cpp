@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "stream_parse.hpp"
+#include "parse_files.hpp"
+#include "eddic_generator.hpp"
+
+namespace {
+
+const char* const path = "bench_stream.eddic";
+
+struct stream_result {
+    bool success;
+    std::size_t blocks;
+    std::size_t peak;
+    std::string diagnostic;
+};
+
+// Feeds text in pieces of piece bytes (of random sizes up to 64 KB with 0)
+stream_result parse_pieces(const std::string& text, std::size_t piece, std::mt19937& generator){
+    stream_parser parser([](const x3_ast::block&){}, path);
+
+    bool success = true;
+    for(std::size_t i = 0; success && i < text.size();){
+        std::size_t size = std::min(text.size() - i, piece ? piece : 1 + generator() % (64 * 1024));
+        success = parser.feed(text.data() + i, size);
+        i += size;
+    }
+
+    success = success && parser.finish();
+
+    return {success, parser.blocks(), parser.peak_buffer(), parser.error()};
+}
+
+// The line echoed by the stream_parser is cut to its buffer: the beginning of a
+// line longer than its window is replaced by "..." and the line stops at the
+// end of the text read
+bool same_diagnostic(const std::string& stream, const std::string& file){
+    if(stream == file){
+        return true;
+    }
+
+    auto split = [](const std::string& diagnostic){
+        std::vector<std::string> lines;
+
+        std::size_t first = 0;
+        std::size_t last;
+        while((last = diagnostic.find('\n', first)) != std::string::npos){
+            lines.push_back(diagnostic.substr(first, last - first));
+            first = last + 1;
+        }
+
+        return lines;
+    };
+
+    auto stream_lines = split(stream);
+    auto file_lines = split(file);
+
+    if(stream_lines.size() != 3 || file_lines.size() != 3 || stream_lines[0] != file_lines[0]){
+        return false;
+    }
+
+    std::string text = stream_lines[1];
+    std::size_t stream_caret = stream_lines[2].size() - 1;
+    std::size_t file_caret = file_lines[2].size() - 1;
+
+    if(text.compare(0, 3, "...") == 0){
+        text.erase(0, 3);
+        stream_caret -= 3;
+    }
+
+    // The text around the caret is the same as around the caret of parse_file
+    return stream_caret <= file_caret && file_lines[1].compare(file_caret - stream_caret, text.size(), text) == 0;
+}
+
+std::string generate(std::size_t size, bool single_line){
+    generator_options options;
+    options.size = size;
+
+    // A line comment would end at the end of the input
+    if(single_line){
+        options.mix["comment"] = 0;
+    }
+
+    std::string text = eddic_generator(options).generate();
+
+    if(single_line){
+        std::replace(text.begin(), text.end(), '\n', ' ');
+    }
+
+    return text;
+}
+
+// Replaces a ';' after position with an unexpected character
+std::string with_error(std::string text, std::size_t position){
+    text[text.find(';', position)] = '!';
+    return text;
+}
+
+bool compare(const std::string& name, const std::string& text, std::mt19937& generator){
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << text;
+    }
+
+    parsed_file file;
+    file.path = path;
+    bool success = parse_file(file);
+
+    bool consistent = true;
+
+    for(std::size_t piece : {std::size_t(1), std::size_t(0), std::size_t(64 * 1024)}){
+        // One byte at a time only for the small inputs
+        if(piece == 1 && text.size() > 256 * 1024){
+            continue;
+        }
+
+        auto result = parse_pieces(text, piece, generator);
+
+        bool same = result.success == success && same_diagnostic(result.diagnostic, file.diagnostic) && (!success || result.blocks == file.ast.blocks.size());
+        consistent = consistent && same;
+
+        std::cout
+            << std::left << std::setw(32) << name
+            << std::setw(10) << (piece == 1 ? "1 B" : piece ? "64 KB" : "random")
+            << std::right << std::setw(8) << (result.success ? "ok" : "failed")
+            << std::setw(10) << result.blocks
+            << std::setw(14) << result.peak
+            << std::setw(8) << (same ? "yes" : "no")
+            << std::endl;
+    }
+
+    std::remove(path);
+
+    return consistent;
+}
+
+} // end of anonymous namespace
+
+int main(){
+    std::mt19937 generator(42);
+
+    std::cout
+        << std::left << std::setw(32) << "input"
+        << std::setw(10) << "pieces"
+        << std::right << std::setw(8) << "status"
+        << std::setw(10) << "blocks"
+        << std::setw(14) << "peak buffer"
+        << std::setw(8) << "same"
+        << std::endl;
+
+    bool consistent = true;
+
+    for(bool single_line : {false, true}){
+        std::string lines = single_line ? "single line" : "lines";
+
+        std::string small = generate(200 * 1024, single_line);
+        consistent = compare(lines, small, generator) && consistent;
+        consistent = compare(lines + ", early error", with_error(small, 1000), generator) && consistent;
+        consistent = compare(lines + ", late error", with_error(small, small.size() * 3 / 4), generator) && consistent;
+
+        // The buffer is bounded by the largest block, even without any newline
+        std::string large = generate(16 * 1024 * 1024, single_line);
+        consistent = compare(lines + ", 16 MB", large, generator) && consistent;
+        consistent = compare(lines + ", 16 MB, late error", with_error(large, large.size() * 3 / 4), generator) && consistent;
+    }
+
+    std::cout << std::endl;
+    std::cout << "consistent with parse_file: " << (consistent ? "yes" : "no") << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "monster.hpp"
+
+namespace {
+
+// vector<vector<...vector<int>...>> nested depth times
+std::string nested_type(std::size_t depth){
+    std::string type;
+
+    for(std::size_t i = 0; i < depth; ++i){
+        type += "vector<";
+    }
+
+    type += "int";
+
+    for(std::size_t i = 0; i < depth; ++i){
+        type += ">";
+    }
+
+    return type;
+}
+
+bool parse_type(const std::string& source){
+    pos_iterator_type it = source.data();
+    pos_iterator_type end = source.data() + source.size();
+
+    x3_ast::type_t result;
+    bool r = x3::phrase_parse(it, end, x3_grammar::type, x3_grammar::skipper, result);
+
+    return r && it == end;
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv){
+    typedef std::chrono::high_resolution_clock clock;
+
+    std::size_t max_depth = argc > 1 ? std::stoul(argv[1]) : 12;
+
+    std::cout
+        << std::left << std::setw(8) << "depth"
+        << std::right << std::setw(10) << "status"
+        << std::setw(14) << "us/parse"
+        << std::setw(10) << "growth"
+        << std::endl;
+
+    double previous = 0.0;
+
+    for(std::size_t depth = 1; depth <= max_depth; ++depth){
+        std::string source = nested_type(depth);
+
+        bool success = parse_type(source);
+
+        std::size_t iterations = 0;
+        auto start = clock::now();
+        auto elapsed = clock::duration::zero();
+        while(iterations == 0 || elapsed < std::chrono::milliseconds(100)){
+            parse_type(source);
+            ++iterations;
+            elapsed = clock::now() - start;
+        }
+
+        double us = std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+
+        std::cout
+            << std::left << std::setw(8) << depth
+            << std::right << std::setw(10) << (success ? "ok" : "failed")
+            << std::fixed << std::setprecision(2)
+            << std::setw(14) << us
+            << std::setw(9) << (previous > 0.0 ? us / previous : 1.0) << "x"
+            << std::endl;
+
+        previous = us;
+    }
+
+    return 0;
+}
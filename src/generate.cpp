@@ -0,0 +1,93 @@
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "eddic_generator.hpp"
+
+namespace {
+
+void usage(){
+    std::cout
+        << "Usage: generate [options]" << std::endl
+        << "  --seed N            seed of the generator (default 42)" << std::endl
+        << "  --size BYTES        minimum size of the source (default 1 MB)" << std::endl
+        << "  --depth N           maximum nesting of the instruction blocks (default 4)" << std::endl
+        << "  --type-depth N      maximum nesting of the template types (default 2)" << std::endl
+        << "  --function-size N   maximum number of instructions per function (default 24)" << std::endl
+        << "  --mix k=v,...       weight of the constructs (e.g. if=10,foreach=0,template=80)" << std::endl
+        << "  -o FILE             output file (default standard output)" << std::endl;
+}
+
+bool parse_mix(const std::string& mix, generator_options& options){
+    std::istringstream stream(mix);
+    std::string entry;
+
+    while(std::getline(stream, entry, ',')){
+        auto equal = entry.find('=');
+
+        if(equal == std::string::npos || !options.mix.count(entry.substr(0, equal))){
+            std::cout << "Invalid mix entry: " << entry << std::endl;
+            return false;
+        }
+
+        options.mix[entry.substr(0, equal)] = std::stoul(entry.substr(equal + 1));
+    }
+
+    return true;
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv){
+    generator_options options;
+    std::string output;
+
+    for(int i = 1; i < argc; ++i){
+        std::string arg(argv[i]);
+
+        if(arg == "-h" || arg == "--help"){
+            usage();
+            return 0;
+        }
+
+        if(i + 1 == argc){
+            usage();
+            return 1;
+        }
+
+        std::string value(argv[++i]);
+
+        if(arg == "--seed"){
+            options.seed = std::stoul(value);
+        } else if(arg == "--size"){
+            options.size = std::stoul(value);
+        } else if(arg == "--depth"){
+            options.depth = std::stoul(value);
+        } else if(arg == "--type-depth"){
+            options.type_depth = std::stoul(value);
+        } else if(arg == "--function-size"){
+            options.function_size = std::stoul(value);
+        } else if(arg == "--mix"){
+            if(!parse_mix(value, options)){
+                return 1;
+            }
+        } else if(arg == "-o"){
+            output = value;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    eddic_generator generator(options);
+
+    if(output.empty()){
+        generator.generate(std::cout);
+    } else {
+        std::ofstream out(output.c_str(), std::ios::binary);
+        generator.generate(out);
+    }
+
+    return 0;
+}
@@ -0,0 +1,199 @@
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ast_cache.hpp"
+#include "mapped_file.hpp"
+
+namespace {
+
+const char magic[8] = {'E', 'D', 'D', 'I', 'C', 'A', 'S', 'T'};
+
+// The layout of the entries, independent of the grammar
+const std::uint32_t format_version = 1;
+
+struct header {
+    char magic[8];
+    std::uint32_t format;
+    std::uint32_t grammar;
+    std::uint64_t hash;
+    std::uint64_t source_size;
+    std::uint64_t data_size;
+    std::uint64_t data_hash;
+};
+
+} // end of anonymous namespace
+
+std::uint64_t x3_ast::content_hash(const char* first, const char* last){
+    const std::uint64_t prime = 0x100000001b3ULL;
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+
+    // FNV-1a on 8 bytes at a time, the hash of a file is computed before each load
+    for(; last - first >= 8; first += 8){
+        std::uint64_t word;
+        std::memcpy(&word, first, sizeof(word));
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 29;
+    }
+
+    for(; first != last; ++first){
+        hash = (hash ^ static_cast<unsigned char>(*first)) * prime;
+    }
+
+    return hash ^ (hash >> 32);
+}
+
+bool x3_ast::serialize(const char* first, const char* last, const source_file& ast, std::string& out){
+    std::string data;
+    cache_detail::writer tree(data, first, last);
+    tree.write(ast);
+
+    if(!tree.valid){
+        return false;
+    }
+
+    header h;
+    std::memcpy(h.magic, magic, sizeof(magic));
+    h.format = format_version;
+    h.grammar = grammar_version;
+    h.hash = content_hash(first, last);
+    h.source_size = last - first;
+
+    // The names of the symbols first, they are interned again when loaded
+    std::string names;
+    cache_detail::writer table(names, first, last);
+    table.varint(tree.symbols.size());
+
+    for(auto symbol : tree.symbols){
+        auto name = symbol.str();
+        table.varint(name.size());
+        names.append(name.data(), name.size());
+    }
+
+    out.clear();
+    out.reserve(sizeof(header) + names.size() + data.size());
+    out.append(sizeof(header), '\0');
+    out += names;
+    out += data;
+
+    h.data_size = out.size() - sizeof(header);
+    h.data_hash = content_hash(&out[sizeof(header)], &out[0] + out.size());
+
+    std::memcpy(&out[0], &h, sizeof(header));
+
+    return true;
+}
+
+bool x3_ast::deserialize(const char* data, std::size_t size, const char* first, const char* last, source_file& ast){
+    return read_entry(data, size, first, last, content_hash(first, last), ast);
+}
+
+bool x3_ast::read_entry(const char* data, std::size_t size, const char* first, const char* last, std::uint64_t hash, source_file& ast){
+    header h;
+
+    if(size < sizeof(header)){
+        return false;
+    }
+
+    std::memcpy(&h, data, sizeof(header));
+
+    if(std::memcmp(h.magic, magic, sizeof(magic)) != 0 || h.format != format_version || h.grammar != grammar_version){
+        return false;
+    }
+
+    if(h.source_size != static_cast<std::uint64_t>(last - first) || h.data_size != size - sizeof(header)){
+        return false;
+    }
+
+    // A truncated or corrupted entry is not used
+    if(h.hash != hash || h.data_hash != content_hash(data + sizeof(header), data + size)){
+        return false;
+    }
+
+    cache_detail::reader reader(data + sizeof(header), data + size, first, last);
+
+    std::uint64_t symbols = reader.varint();
+
+    if(symbols > size){
+        return false;
+    }
+
+    reader.symbols.reserve(symbols);
+
+    for(std::uint64_t i = 0; i < symbols && reader.valid; ++i){
+        std::uint64_t length = reader.varint();
+
+        if(length > static_cast<std::uint64_t>(reader.end - reader.it)){
+            return false;
+        }
+
+        // The empty symbol is not in the table
+        reader.symbols.push_back(length ? symbol_table::global().intern(string_view(reader.it, length)) : symbol());
+        reader.it += length;
+    }
+
+    // Created in the current arena, not in the one of the caller
+    source_file result;
+    reader.read(result);
+
+    if(!reader.valid || reader.it != reader.end){
+        return false;
+    }
+
+    ast = std::move(result);
+
+    return true;
+}
+
+std::string x3_ast::ast_cache::entry(std::uint64_t hash) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+
+    return directory + "/" + name + "-" + std::to_string(grammar_version) + ".ast";
+}
+
+bool x3_ast::ast_cache::load(const char* first, const char* last, source_file& ast) const {
+    std::uint64_t hash = content_hash(first, last);
+
+    mapped_file cached;
+
+    if(!cached.open(entry(hash))){
+        return false;
+    }
+
+    return read_entry(cached.begin(), cached.size(), first, last, hash, ast);
+}
+
+bool x3_ast::ast_cache::store(const char* first, const char* last, const source_file& ast) const {
+    std::string data;
+
+    if(!serialize(first, last, ast, data)){
+        return false;
+    }
+
+    ::mkdir(directory.c_str(), 0755);
+
+    std::string path = entry(content_hash(first, last));
+    std::string temporary = path + "." + std::to_string(::getpid()) + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+    {
+        std::ofstream stream(temporary, std::ios::binary);
+        stream.write(data.data(), data.size());
+
+        if(!stream.flush()){
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+
+    if(std::rename(temporary.c_str(), path.c_str()) != 0){
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <iterator>
+
+#include "incremental.hpp"
+#include "brace_scanner.hpp"
+#include "expect.hpp"
+#include "line_index.hpp"
+
+bool incremental_source::parse_region(const std::shared_ptr<const std::string>& buffer, std::vector<segment>& parsed, x3_ast::vector<x3_ast::block>& blocks, const char*& error, std::string& message){
+    const char* it = buffer->data();
+    const char* last = it + buffer->size();
+
+    while(it != last){
+        const char* first = it;
+
+        // The spaces and comments at the end of the region have no block
+        if(x3_grammar::skipper_parser::skip(it, last) == last){
+            parsed.push_back({buffer, first, last, false, false});
+            break;
+        }
+
+        x3_ast::block block;
+
+        x3_grammar::expectation_error<pos_iterator_type> failure;
+        bool r = x3_grammar::catch_expectation(failure, [&]{ return x3::phrase_parse(it, last, x3_grammar::block, x3_grammar::skipper, block); });
+
+        if(failure){
+            error = failure.where;
+            message = "error: expected " + failure.which;
+            return false;
+        }
+
+        if(!r || it == first){
+            error = x3_grammar::skipper_parser::skip(first, last);
+            message = "error: unexpected input";
+            return false;
+        }
+
+        parsed.push_back({buffer, first, it, true, false});
+        blocks.push_back(std::move(block));
+    }
+
+    return true;
+}
+
+bool incremental_source::parse(std::string text){
+    auto buffer = std::make_shared<const std::string>(std::move(text));
+
+    segments.clear();
+    result.blocks.clear();
+    error_message.clear();
+
+    length = parsed_size = buffer->size();
+
+    const char* error;
+    std::string message;
+    if(!parse_region(buffer, segments, result.blocks, error, message)){
+        segments.clear();
+        result.blocks.clear();
+
+        segments.push_back({buffer, buffer->data(), buffer->data() + buffer->size(), false, true});
+        error_offset = error - buffer->data();
+        error_message = message;
+
+        return false;
+    }
+
+    return true;
+}
+
+bool incremental_source::edit(std::size_t offset, std::size_t removed, const std::string& replacement){
+    offset = std::min(offset, length);
+    removed = std::min(removed, length - offset);
+
+    // The segments [b, e) touched by the edit, with the block before an edit at
+    // its start and the block after an edit at its end
+    std::size_t b = 0;
+    std::size_t start = 0;
+    while(b + 1 < segments.size() && start + segments[b].size() < offset){
+        start += segments[b++].size();
+    }
+
+    std::size_t e = b;
+    std::size_t end = start;
+    while(e < segments.size() && (e == b || end <= offset + removed)){
+        end += segments[e++].size();
+    }
+
+    // The text that failed to parse is parsed again with the edit, which may
+    // have fixed it (e.g. by closing a comment opened before it)
+    for(std::size_t i = 0; i < segments.size(); ++i){
+        if(segments[i].invalid){
+            while(b > i){
+                start -= segments[--b].size();
+            }
+
+            e = std::max(e, i + 1);
+        }
+    }
+
+    while(true){
+        std::string text;
+        for(std::size_t i = b; i < e; ++i){
+            text.append(segments[i].first, segments[i].last);
+        }
+
+        text.replace(offset - start, removed, replacement);
+
+        auto buffer = std::make_shared<const std::string>(std::move(text));
+
+        std::vector<segment> parsed;
+        x3_ast::vector<x3_ast::block> blocks;
+        const char* error = nullptr;
+        std::string message;
+
+        bool success = parse_region(buffer, parsed, blocks, error, message);
+
+        // With more '{' than '}' (e.g. a removed '}'), the region continues
+        // in the next blocks and is extended until it parses again. A comment
+        // or a string left open continues up to the end. Otherwise the error
+        // is in the region.
+        if(!success && e < segments.size()){
+            const char* region_first = buffer->data();
+            const char* region_last = region_first + buffer->size();
+
+            if(x3_grammar::unterminated(region_first, region_last)){
+                e = segments.size();
+                continue;
+            }
+
+            if(x3_grammar::brace_balance(region_first, region_last) > 0){
+                e = std::min(segments.size(), e + (e - b));
+                continue;
+            }
+        }
+
+        std::size_t first_block = std::count_if(segments.begin(), segments.begin() + b, [](const segment& s){ return s.has_block; });
+        std::size_t old_blocks = std::count_if(segments.begin() + b, segments.begin() + e, [](const segment& s){ return s.has_block; });
+
+        if(!success){
+            parsed.clear();
+            blocks.clear();
+            parsed.push_back({buffer, buffer->data(), buffer->data() + buffer->size(), false, true});
+        }
+
+        result.blocks.erase(result.blocks.begin() + first_block, result.blocks.begin() + first_block + old_blocks);
+        result.blocks.insert(result.blocks.begin() + first_block, std::make_move_iterator(blocks.begin()), std::make_move_iterator(blocks.end()));
+
+        segments.erase(segments.begin() + b, segments.begin() + e);
+        segments.insert(segments.begin() + b, parsed.begin(), parsed.end());
+
+        length = length - removed + replacement.size();
+        parsed_size = buffer->size();
+
+        if(!success){
+            error_offset = start + (error - buffer->data());
+            error_message = message;
+            return false;
+        }
+
+        // All the invalid segments were in the region
+        error_message.clear();
+
+        return true;
+    }
+}
+
+std::string incremental_source::text() const {
+    std::string contents;
+    contents.reserve(length);
+
+    for(auto& segment : segments){
+        contents.append(segment.first, segment.last);
+    }
+
+    return contents;
+}
+
+std::vector<std::size_t> incremental_source::block_offsets() const {
+    std::vector<std::size_t> offsets;
+
+    std::size_t offset = 0;
+    for(auto& segment : segments){
+        if(segment.has_block){
+            offsets.push_back(offset);
+        }
+
+        offset += segment.size();
+    }
+
+    return offsets;
+}
+
+std::string incremental_source::error() const {
+    if(valid()){
+        return "";
+    }
+
+    // Only computed when asked for, it goes through the whole text
+    std::string contents = text();
+
+    auto where = line_index(contents.data(), contents.data() + contents.size(), "").get(error_offset);
+    return std::to_string(where.line) + ":" + std::to_string(where.column) + ": " + error_message;
+}
@@ -0,0 +1,236 @@
+#include <boost/fusion/include/at_c.hpp>
+
+#include "monster.hpp"
+#include "profile.hpp"
+#include "expect.hpp"
+#include "memo.hpp"
+#include "recovery.hpp"
+
+namespace fusion = boost::fusion;
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Woverloaded-shift-op-parentheses"
+
+namespace x3_grammar {
+
+    // The lists of the semantic actions, with the containers of the AST
+    typedef x3::identity<struct values> values_id;
+    x3::rule<values_id, x3_ast::vector<x3_ast::value_t>> const values("values");
+
+    typedef x3::identity<struct instructions> instructions_id;
+    x3::rule<instructions_id, x3_ast::vector<x3_ast::instruction>> const instructions("instructions");
+
+    // Possibly empty, an optional vector in the action warns with g++ -O2
+    auto const values_def =
+        -(value % ',');
+
+    auto const instructions_def =
+        recover_list(instruction);
+
+    // The declarations and the two foreach share a prefix, parsed only once.
+    // The prefix is stored in _val and the next token decides what it becomes.
+
+    auto const start_declaration = [](auto& ctx){
+        x3_ast::variable_declaration declaration;
+        declaration.variable_type = std::move(fusion::at_c<0>(x3::_attr(ctx)));
+        declaration.variable_name = std::move(fusion::at_c<1>(x3::_attr(ctx)));
+        x3::_val(ctx) = std::move(declaration);
+    };
+
+    auto const make_struct_declaration = [](auto& ctx){
+        auto& prefix = boost::get<x3_ast::variable_declaration>(x3::_val(ctx).get());
+
+        x3_ast::struct_declaration declaration;
+        declaration.variable_type = std::move(prefix.variable_type);
+        declaration.variable_name = std::move(prefix.variable_name);
+
+        declaration.values = std::move(x3::_attr(ctx));
+
+        x3::_val(ctx) = std::move(declaration);
+    };
+
+    auto const make_array_declaration = [](auto& ctx){
+        auto& prefix = boost::get<x3_ast::variable_declaration>(x3::_val(ctx).get());
+
+        x3_ast::array_declaration declaration;
+        declaration.array_type = std::move(prefix.variable_type);
+        declaration.array_name = std::move(prefix.variable_name);
+        declaration.size = std::move(x3::_attr(ctx));
+        x3::_val(ctx) = std::move(declaration);
+    };
+
+    auto const make_variable_declaration = [](auto& ctx){
+        boost::get<x3_ast::variable_declaration>(x3::_val(ctx).get()).value = std::move(x3::_attr(ctx));
+    };
+
+    auto const start_foreach = [](auto& ctx){
+        x3_ast::foreach foreach;
+        foreach.variable_type = std::move(fusion::at_c<0>(x3::_attr(ctx)));
+        foreach.variable_name = std::move(fusion::at_c<1>(x3::_attr(ctx)));
+        x3::_val(ctx) = std::move(foreach);
+    };
+
+    auto const make_foreach = [](auto& ctx){
+        auto& foreach = boost::get<x3_ast::foreach>(x3::_val(ctx).get());
+        foreach.from = fusion::at_c<0>(x3::_attr(ctx));
+        foreach.to = fusion::at_c<1>(x3::_attr(ctx));
+    };
+
+    auto const make_foreach_in = [](auto& ctx){
+        auto& prefix = boost::get<x3_ast::foreach>(x3::_val(ctx).get());
+
+        x3_ast::foreach_in foreach;
+        foreach.variable_type = std::move(prefix.variable_type);
+        foreach.variable_name = std::move(prefix.variable_name);
+        foreach.array_name = std::move(x3::_attr(ctx));
+        x3::_val(ctx) = std::move(foreach);
+    };
+
+    struct set_foreach_instructions {
+        typedef void result_type;
+
+        x3_ast::vector<x3_ast::instruction>& instructions;
+
+        void operator()(x3_ast::foreach& foreach) const {
+            foreach.instructions = std::move(instructions);
+        }
+
+        void operator()(x3_ast::foreach_in& foreach) const {
+            foreach.instructions = std::move(instructions);
+        }
+
+        // The other instructions are never built by foreach
+        template<typename Instruction>
+        void operator()(Instruction&) const {}
+    };
+
+    auto const make_foreach_instructions = [](auto& ctx){
+        boost::apply_visitor(set_foreach_instructions{x3::_attr(ctx)}, x3::_val(ctx));
+    };
+
+    // The instructions starting with a keyword are selected by a single
+    // lookup of the keyword, the rules do not match the keyword again
+
+    auto const keyword_instruction = dispatch<x3_ast::instruction>(
+        {"if", "foreach", "while", "do", "return", "delete"},
+        if_,
+        foreach,
+        while_,
+        do_while,
+        return_ >> expect[';'],
+        delete_ >> expect[';']);
+
+    auto const instruction_def =
+            keyword_instruction
+        |   declaration;
+
+    auto const foreach_def =
+            (
+                    x3::lit('(')
+                >>  type
+                >>  identifier
+            )[start_foreach]
+        >>  (
+                    (keyword("from") >> x3::int_ >> keyword("to") >> x3::int_)[make_foreach]
+                |   (keyword("in") >> identifier)[make_foreach_in]
+            )
+        >>  ')'
+        >>  '{'
+        >>  instructions[make_foreach_instructions]
+        >>  '}';
+
+    auto const declaration_def =
+            (
+                    type
+                >>  identifier
+            )[start_declaration]
+        >>  (
+                    ('(' >> values >> ')')[make_struct_declaration]
+                |   ('[' >> value >> ']')[make_array_declaration]
+                |   (-('=' >> value))[make_variable_declaration]
+            )
+        >>  expect[';'];
+
+    auto const while__def =
+            x3::lit('(')
+        >>  value
+        >>  ')'
+        >>  '{'
+        >>  recover_list(instruction)
+        >>  '}';
+
+    auto const do_while_def =
+            x3::lit('{')
+        >>  recover_list(instruction)
+        >>  '}'
+        >>  keyword("while")
+        >>  '('
+        >>  value
+        >>  ')'
+        >>  ';';
+
+    // Only used in the structures, after a failed member_declaration
+    auto const array_declaration_def =
+            memo[type]
+        >>  identifier
+        >>  '['
+        >>  value
+        >>  ']';
+
+    auto const return__def =
+            x3::attr(1)
+        >>  value;
+
+    auto const delete__def =
+            x3::attr(1)
+        >>  value;
+
+    auto const if__def =
+            x3::lit('(')
+        >>  value
+        >>  ')'
+        >>  '{'
+        >>  recover_list(instruction)
+        >>  '}'
+        >>  *else_if
+        >>  -else_;
+
+    auto const else_if_def =
+            keyword("else")
+        >>  keyword("if")
+        >>  '('
+        >>  value
+        >>  ')'
+        >>  '{'
+        >>  recover_list(instruction)
+        >>  '}';
+
+    auto const else__def =
+            keyword("else")
+        >>  x3::attr(1)
+        >>  '{'
+        >>  recover_list(instruction)
+        >>  '}';
+
+    MONSTER_DEFINE(
+        instruction,
+        foreach,
+        while_,
+        do_while ,
+        declaration,
+        values,
+        instructions,
+        array_declaration,
+        return_,
+        delete_,
+        if_,
+        else_if,
+        else_
+    );
+
+    MONSTER_INSTANTIATE(instruction_rule);
+    MONSTER_INSTANTIATE(array_declaration_rule);
+
+} // end of grammar namespace
+
+#pragma clang diagnostic pop
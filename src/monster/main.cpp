@@ -0,0 +1,112 @@
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <thread>
+
+#include "parse_files.hpp"
+#include "stream_parse.hpp"
+#include "profile.hpp"
+
+int main(int argc, char* argv[]){
+    std::size_t threads = std::thread::hardware_concurrency();
+    bool split = false;
+    bool stream = false;
+    bool recover = false;
+    std::unique_ptr<x3_ast::ast_cache> cache;
+    std::string profile;
+    std::vector<std::string> paths;
+
+    for(int i = 1; i < argc; ++i){
+        std::string arg(argv[i]);
+
+        if(arg == "-j" && i + 1 < argc){
+            threads = std::stoul(argv[++i]);
+        } else if(arg == "--split"){
+            split = true;
+        } else if(arg == "--recover"){
+            recover = true;
+        } else if(arg == "--stream"){
+            stream = true;
+        } else if(arg == "--profile" && i + 1 < argc){
+            profile = argv[++i];
+        } else if(arg == "--cache" && i + 1 < argc){
+            cache.reset(new x3_ast::ast_cache(argv[++i]));
+        } else {
+            paths.push_back(arg);
+        }
+    }
+
+    if(paths.empty()){
+        std::cout << "Usage: monster [-j threads] [--split | --stream] [--recover] [--cache directory] [--profile file.folded] file..." << std::endl;
+        return 1;
+    }
+
+    // Only parse_files() reads the cache and recovers from the errors
+    if((split || stream) && (cache || recover)){
+        std::cout << (split ? "--split" : "--stream") << " cannot be used with --cache or --recover" << std::endl;
+        return 1;
+    }
+
+#ifndef MONSTER_PROFILE
+    if(!profile.empty()){
+        std::cout << "--profile needs monster_profile (built with MONSTER_PROFILE)" << std::endl;
+        return 1;
+    }
+#endif
+
+    parsed_files results;
+
+    if(stream){
+        // One file after another, one block at a time, the blocks are dropped after their parse
+        for(auto& path : paths){
+            parsed_file file;
+            file.path = path;
+
+            stream_parser parser([](const x3_ast::block&){}, path);
+
+            file.success = parse_stream(path, parser);
+            file.diagnostic = parser.valid() ? (file.success ? "" : "Unable to open " + path + "\n") : parser.error();
+
+            results.files.push_back(std::move(file));
+        }
+    } else if(split){
+        // One file after another, each one with all the threads
+        for(auto& path : paths){
+            auto file = parse_split_file(path, threads);
+
+            std::move(file.arenas.begin(), file.arenas.end(), std::back_inserter(results.arenas));
+            std::move(file.files.begin(), file.files.end(), std::back_inserter(results.files));
+        }
+    } else {
+        results = parse_files(paths, threads, cache.get(), recover);
+    }
+
+    std::size_t failed = 0;
+
+    for(auto& file : results.files){
+        std::cout << file.diagnostic;
+
+        if(!file.success){
+            ++failed;
+        }
+    }
+
+    if(paths.size() == 1){
+        std::cout << (failed ? "failed" : "succeeded") << std::endl;
+    } else {
+        std::cout << (paths.size() - failed) << " succeeded, " << failed << " failed" << std::endl;
+    }
+
+#ifdef MONSTER_PROFILE
+    if(!profile.empty()){
+        std::cout << std::endl;
+        x3_grammar::rule_profile::report(std::cout);
+
+        std::ofstream folded(profile);
+        x3_grammar::rule_profile::folded(folded);
+    }
+#endif
+
+    return failed ? 1 : 0;
+}
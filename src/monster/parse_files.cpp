@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <exception>
+#include <iterator>
+
+#include "parse_files.hpp"
+#include "brace_scanner.hpp"
+#include "expect.hpp"
+#include "line_index.hpp"
+#include "recovery.hpp"
+#include "work_stealing_pool.hpp"
+
+namespace {
+
+// Not worth a thread under this size
+const std::size_t min_part_size = 256 * 1024;
+
+// The ends of the parts of the input, right after the '}' closing a top-level block, about every size / parts bytes
+std::vector<const char*> split_blocks(const char* first, const char* last, std::size_t parts){
+    std::vector<const char*> ends;
+
+    std::size_t target = (last - first) / parts;
+    const char* next = first + target;
+
+    std::size_t depth = 0;
+
+    x3_grammar::scan_braces(first, last, [&](const char* brace){
+        if(*brace == '{'){
+            ++depth;
+        } else if(depth > 0){
+            // Not too close to the end either, the last part would be too small
+            if(--depth == 0 && brace + 1 >= next && static_cast<std::size_t>(last - (brace + 1)) >= target / 2){
+                ends.push_back(brace + 1);
+                next = brace + 1 + target;
+            }
+        }
+
+        return true;
+    });
+
+    ends.push_back(last);
+
+    return ends;
+}
+
+} // end of anonymous namespace
+
+bool parse_file(parsed_file& file, const x3_ast::ast_cache* cache, bool recover){
+    file.input.reset(new mapped_file());
+
+    if(!file.input->open(file.path)){
+        file.diagnostic = "Unable to open " + file.path + "\n";
+        return file.success = false;
+    }
+
+    if(cache && cache->load(file.input->begin(), file.input->end(), file.ast)){
+        return file.success = true;
+    }
+
+    pos_iterator_type it = file.input->begin();
+    pos_iterator_type end = file.input->end();
+
+    line_index lines(file.input->begin(), file.input->end(), file.path);
+
+    // Created in the current arena, not in the one of the caller
+    x3_ast::source_file result;
+
+    x3_grammar::error_recovery recovery;
+    std::unique_ptr<x3_grammar::recovery_scope> scope(recover ? new x3_grammar::recovery_scope(recovery) : nullptr);
+
+    try {
+        x3_grammar::expectation_error<pos_iterator_type> failure;
+        bool r = x3_grammar::catch_expectation(failure, [&]{ return x3::phrase_parse(it, end, x3_grammar::parser, x3_grammar::skipper, result); });
+
+        if(failure){
+            file.diagnostic = lines.diagnostic(failure.where - file.input->begin(), "error: expected " + failure.which);
+            return file.success = false;
+        }
+
+        for(auto& error : recovery.errors){
+            file.diagnostic += lines.diagnostic(error.where - file.input->begin(), error.message);
+        }
+
+        if(r && it == end){
+            // The blocks parsed around the errors are kept
+            file.ast = std::move(result);
+
+            if(!recovery.errors.empty()){
+                return file.success = false;
+            }
+
+            if(cache){
+                cache->store(file.input->begin(), file.input->end(), file.ast);
+            }
+
+            return file.success = true;
+        }
+
+        file.diagnostic += lines.diagnostic(it - file.input->begin(), "error: unexpected input");
+    } catch(const std::exception& e){
+        file.diagnostic = file.path + ": error: " + e.what() + "\n";
+    }
+
+    return file.success = false;
+}
+
+parsed_files parse_files(const std::vector<std::string>& paths, std::size_t threads, const x3_ast::ast_cache* cache, bool recover){
+    work_stealing_pool pool(std::min(threads, paths.size()));
+
+    parsed_files results;
+
+    for(std::size_t worker = 0; worker < pool.size(); ++worker){
+        results.arenas.emplace_back(new x3_ast::arena());
+    }
+
+    results.files.resize(paths.size());
+
+    pool.run(paths.size(), [&](std::size_t worker, std::size_t index){
+        x3_ast::arena_scope scope(*results.arenas[worker]);
+
+        auto& file = results.files[index];
+        file.path = paths[index];
+        parse_file(file, cache, recover);
+    });
+
+    return results;
+}
+
+parsed_files parse_split_file(const std::string& path, std::size_t threads){
+    parsed_files results;
+
+    results.files.resize(1);
+
+    auto& file = results.files.front();
+    file.path = path;
+    file.input.reset(new mapped_file());
+
+    if(!file.input->open(path)){
+        file.diagnostic = "Unable to open " + path + "\n";
+        return results;
+    }
+
+    // A few parts per thread, so that the threads can steal the parts of the others
+    std::size_t parts = std::max<std::size_t>(1, std::min(threads * 4, file.input->size() / min_part_size));
+
+    auto ends = split_blocks(file.input->begin(), file.input->end(), parts);
+
+    work_stealing_pool pool(std::min(threads, ends.size()));
+
+    for(std::size_t worker = 0; worker < pool.size(); ++worker){
+        results.arenas.emplace_back(new x3_ast::arena());
+    }
+
+    std::vector<x3_ast::vector<x3_ast::block>> blocks(ends.size());
+    std::vector<char> parsed(ends.size(), false);
+
+    pool.run(ends.size(), [&](std::size_t worker, std::size_t index){
+        x3_ast::arena_scope scope(*results.arenas[worker]);
+
+        pos_iterator_type it = index ? ends[index - 1] : file.input->begin();
+        pos_iterator_type end = ends[index];
+
+        x3_ast::vector<x3_ast::block> result;
+
+        x3_grammar::expectation_error<pos_iterator_type> failure;
+        parsed[index] = x3_grammar::catch_expectation(failure, [&]{ return x3::phrase_parse(it, end, x3_grammar::blocks, x3_grammar::skipper, result); }) && it == end;
+
+        blocks[index] = std::move(result);
+    });
+
+    x3_ast::arena_scope scope(*results.arenas.front());
+
+    // The diagnostic of an invalid file is the one of a sequential parse
+    if(std::find(parsed.begin(), parsed.end(), false) != parsed.end()){
+        parse_file(file);
+        return results;
+    }
+
+    x3_ast::source_file result;
+
+    for(auto& part : blocks){
+        std::move(part.begin(), part.end(), std::back_inserter(result.blocks));
+    }
+
+    file.ast = std::move(result);
+    file.success = true;
+
+    return results;
+}
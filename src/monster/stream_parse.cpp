@@ -0,0 +1,198 @@
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "stream_parse.hpp"
+#include "brace_scanner.hpp"
+#include "expect.hpp"
+
+namespace {
+
+const std::size_t read_size = 64 * 1024;
+
+// The most of the current line kept before the text not parsed yet
+const std::size_t line_window = 4 * 1024;
+
+const std::size_t tab_chars = 4;
+
+// A line ends with a \n or a \r not followed by a \n (as in line_index)
+bool line_end(const char* it, const char* last){
+    return *it == '\n' || (*it == '\r' && (it + 1 == last || *(it + 1) != '\n'));
+}
+
+// Moves the line and the column of first to the ones of last, the buffer ending at end
+void advance(const char* first, const char* last, const char* end, std::size_t& line, std::size_t& column){
+    for(const char* it = first; it != last; ++it){
+        if(line_end(it, end)){
+            ++line;
+            column = 1;
+        } else if(*it == '\t'){
+            column += tab_chars - (column - 1) % tab_chars;
+        } else if(*it != '\r'){
+            ++column;
+        }
+    }
+}
+
+} // end of anonymous namespace
+
+bool stream_parser::feed(const char* data, std::size_t size){
+    if(!valid()){
+        return false;
+    }
+
+    buffer.append(data, size);
+    peak = std::max(peak, buffer.size());
+
+    // Without a complete block, scanning after each small piece would be quadratic
+    if(buffer.size() < next_scan){
+        return true;
+    }
+
+    const char* last = buffer.data() + buffer.size();
+    const char* end = nullptr;
+    std::size_t depth = 0;
+
+    // The end of the last top-level block, after a ';' or a '}' outside of the braces
+    x3_grammar::scan_delimiters(buffer.data() + line_prefix, last, [&](const char* it){
+        // The last character may be in a char cut by the end of the piece ('}' of '}')
+        if(it + 1 == last){
+            return false;
+        } else if(*it == '{'){
+            ++depth;
+        } else if(*it == ';' ? depth == 0 : (depth == 0 || --depth == 0)){
+            end = it + 1;
+        }
+
+        return true;
+    });
+
+    if(!end){
+        next_scan = 2 * buffer.size();
+        return true;
+    }
+
+    next_scan = 0;
+
+    return parse_until(end);
+}
+
+bool stream_parser::finish(){
+    if(!valid()){
+        return false;
+    }
+
+    return parse_until(buffer.data() + buffer.size());
+}
+
+bool stream_parser::parse_until(const char* end){
+    pos_iterator_type it = buffer.data() + line_prefix;
+
+    while(true){
+        const char* first = it;
+
+        if(x3_grammar::skipper_parser::skip(it, end) == end){
+            break;
+        }
+
+        x3_ast::block block;
+
+        x3_grammar::expectation_error<pos_iterator_type> failure;
+        bool r = x3_grammar::catch_expectation(failure, [&]{ return x3::phrase_parse(it, end, x3_grammar::block, x3_grammar::skipper, block); });
+
+        if(failure){
+            set_error(failure.where, "error: expected " + failure.which);
+            return false;
+        }
+
+        if(!r || it == first){
+            set_error(x3_grammar::skipper_parser::skip(first, end), "error: unexpected input");
+            return false;
+        }
+
+        ++parsed_blocks;
+        callback(block);
+    }
+
+    const char* data = buffer.data();
+    const char* last = data + buffer.size();
+
+    // Only the parsed text of the current line is kept, at most its last line_window bytes
+    const char* start = end - std::min<std::size_t>(end - data, line_window);
+    for(const char* it = end; it != start; --it){
+        if(line_end(it - 1, last)){
+            start = it;
+            break;
+        }
+    }
+
+    advance(data, start, last, line, column);
+    line_prefix = end - start;
+
+    buffer.erase(0, start - data);
+
+    return true;
+}
+
+void stream_parser::set_error(const char* where, const std::string& message){
+    const char* data = buffer.data();
+    const char* last = data + buffer.size();
+
+    std::size_t error_line = line;
+    std::size_t error_column = column;
+    advance(data, where, last, error_line, error_column);
+
+    const char* begin = where;
+    while(begin != data && !line_end(begin - 1, last)){
+        --begin;
+    }
+
+    const char* finish = std::find_if(where, last, [](char c){ return c == '\n' || c == '\r'; });
+
+    // The beginning of a line longer than the window is not in the buffer anymore
+    std::string text(begin, finish);
+    std::size_t caret = error_column;
+
+    if(begin == data && column > 1){
+        std::size_t caret_line = 1;
+        caret = 1;
+        advance(begin, where, last, caret_line, caret);
+
+        text = "..." + text;
+        caret += 3;
+    }
+
+    diagnostic = file + ":" + std::to_string(error_line) + ":" + std::to_string(error_column) + ": " + message + "\n";
+    diagnostic += text + "\n";
+    diagnostic += std::string(caret - 1, ' ') + "^\n";
+}
+
+bool parse_stream(const std::string& path, stream_parser& parser){
+    int fd = path == "-" ? STDIN_FILENO : ::open(path.c_str(), O_RDONLY);
+    if(fd < 0){
+        return false;
+    }
+
+    char chunk[read_size];
+    bool result = true;
+
+    while(result){
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+
+        if(n < 0){
+            result = false;
+        } else if(n == 0){
+            result = parser.finish();
+            break;
+        } else {
+            result = parser.feed(chunk, n);
+        }
+    }
+
+    if(fd != STDIN_FILENO){
+        ::close(fd);
+    }
+
+    return result;
+}
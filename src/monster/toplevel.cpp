@@ -0,0 +1,120 @@
+#include "monster.hpp"
+#include "profile.hpp"
+#include "expect.hpp"
+#include "memo.hpp"
+#include "recovery.hpp"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Woverloaded-shift-op-parentheses"
+
+namespace x3_grammar {
+
+    // source_file only wraps the vector of blocks, going through a rule
+    // with the vector as attribute avoids the single element struct issue
+    auto const source_file_def =
+        blocks;
+
+    auto const blocks_def =
+        recover_top_level(block);
+
+    // The blocks starting with a type are tried one after another at the
+    // same position, memo[type] parses the type only once when enabled
+    auto const block_def =
+            standard_import
+        |   import
+        |   template_struct
+        |   template_function_declaration
+        |   (global_array_declaration >> expect[';'])
+        |   (global_variable_declaration >> expect[';']);
+
+    auto const standard_import_def =
+            keyword("import")
+        >>  '<'
+        >>  expect[view[x3::lexeme[*x3::alpha]]]
+        >>  expect['>'];
+
+    auto const import_def =
+            keyword("import")
+        >>  '"'
+        >>  expect[view[x3::lexeme[*x3::alpha]]]
+        >>  expect['"'];
+
+    auto const template_function_declaration_def =
+            -(
+                    keyword("template")
+                >>  '<'
+                >>  (keyword("type") >> type_name) % ','
+                >>  '>'
+            )
+        >>  memo[type]
+        >>  identifier
+        >>  '('
+        >>  -(function_parameter % ',')
+        >>  expect[')']
+        >>  expect['{']
+        >>  expect[recover_list(instruction)]
+        >>  expect['}'];
+
+    auto const global_variable_declaration_def =
+            memo[type]
+        >>  identifier
+        >>  -('=' >> value);
+
+    auto const global_array_declaration_def =
+            memo[type]
+        >>  identifier
+        >>  '['
+        >>  value
+        >>  ']';
+
+    auto const function_parameter_def =
+            type
+        >>  identifier;
+
+    auto const member_declaration_def =
+            memo[type]
+        >>  identifier
+        >>  ';';
+
+    auto template_struct_def =
+            -(
+                    keyword("template")
+                >>  '<'
+                >>  (keyword("type") >> type_name) % ','
+                >>  '>'
+            )
+        >>  keyword("struct")
+        >>  type_name
+        >>  -(
+                    keyword("extends")
+                >>  type
+             )
+        >>  '{'
+        >>  *(
+                    member_declaration
+                |   (array_declaration >> ';')
+                |   template_function_declaration
+             )
+        >>  '}';
+
+    MONSTER_DEFINE(
+        source_file,
+        blocks,
+        block,
+        function_parameter,
+        template_function_declaration,
+        global_variable_declaration,
+        global_array_declaration,
+        standard_import,
+        import,
+        member_declaration,
+        template_struct
+    );
+
+    MONSTER_INSTANTIATE(source_file_rule);
+    MONSTER_INSTANTIATE(blocks_rule);
+    MONSTER_INSTANTIATE(block_rule);
+
+} // end of grammar namespace
+
+#pragma clang diagnostic pop
@@ -0,0 +1,67 @@
+#include "monster.hpp"
+#include "profile.hpp"
+#include "expect.hpp"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Woverloaded-shift-op-parentheses"
+
+namespace x3_grammar {
+
+    auto const const_ =
+            (keyword("const") >> expect[x3::attr(true)])
+        |   x3::attr(false);
+
+    // The suffixes wrap the base type parsed so far
+
+    auto const set_base_type = [](auto& ctx){
+        x3::_val(ctx) = std::move(x3::_attr(ctx));
+    };
+
+    auto const make_array_type = [](auto& ctx){
+        x3_ast::array_type array_type;
+        array_type.base_type = std::move(x3::_val(ctx));
+        x3::_val(ctx) = std::move(array_type);
+    };
+
+    auto const make_pointer_type = [](auto& ctx){
+        x3_ast::pointer_type pointer_type;
+        pointer_type.base_type = std::move(x3::_val(ctx));
+        x3::_val(ctx) = std::move(pointer_type);
+    };
+
+    // The base type is parsed only once and then completed by its suffix,
+    // instead of being parsed again by each alternative
+
+    auto const type_def =
+            base_type[set_base_type]
+        >>  -(
+                    (x3::lit('[') >> ']')[make_array_type]
+                |   x3::lit('*')[make_pointer_type]
+            );
+
+    auto const base_type_def =
+            template_type
+        |   simple_type;
+
+    auto const simple_type_def =
+            const_
+        >>  type_name;
+
+    auto const template_type_def =
+            type_name
+        >>  '<'
+        >>  type % ','
+        >>  '>';
+
+    MONSTER_DEFINE(
+        type,
+        base_type,
+        simple_type,
+        template_type
+    );
+
+    MONSTER_INSTANTIATE(type_rule);
+
+} // end of grammar namespace
+
+#pragma clang diagnostic pop
@@ -0,0 +1,58 @@
+#include "monster.hpp"
+#include "profile.hpp"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Woverloaded-shift-op-parentheses"
+
+namespace x3_grammar {
+
+    x3::real_parser<double, x3::strict_real_policies<double>> strict_double;
+
+    auto const integer_literal_def =
+        x3::int_;
+
+    auto const integer_suffix_literal_def =
+        x3::lexeme[
+                x3::int_
+            >>  view[+x3::alpha]
+        ];
+
+    auto const float_literal_def =
+        strict_double;
+
+    auto const char_literal_def =
+            x3::lit('\'')
+        >>  x3::char_
+        >>  x3::lit('\'');
+
+    auto const string_literal_def =
+            x3::lit('"')
+        >>  x3::no_skip[view[*(x3::char_ - '"')]]
+        >>  x3::lit('"');
+
+    auto const variable_value_def =
+        identifier;
+
+    auto const value_def =
+            variable_value
+        |   integer_suffix_literal
+        |   float_literal
+        |   integer_literal
+        |   string_literal
+        |   char_literal;
+
+    MONSTER_DEFINE(
+        value,
+        integer_literal,
+        integer_suffix_literal,
+        float_literal,
+        char_literal,
+        string_literal,
+        variable_value
+    );
+
+    MONSTER_INSTANTIATE(value_rule);
+
+} // end of grammar namespace
+
+#pragma clang diagnostic pop
@@ -8,7 +8,9 @@
 #include <boost/spirit/home/x3.hpp>
 #include <boost/spirit/home/x3/support/ast/variant.hpp>
 #include <boost/fusion/include/adapt_struct.hpp>
-#include <boost/spirit/include/classic_position_iterator.hpp>
+
+#include "line_index.hpp"
+#include "mapped_file.hpp"
 
 namespace x3 = boost::spirit::x3;
 
@@ -92,27 +94,24 @@ namespace x3_grammar {
 #pragma clang diagnostic pop
 
 bool parse(const std::string& file){
-    std::ifstream in(file.c_str(), std::ios::binary);
-    in.unsetf(std::ios::skipws);
-
-    in.seekg(0, std::istream::end);
-    std::size_t size(static_cast<size_t>(in.tellg()));
-    in.seekg(0, std::istream::beg);
-
-    std::string file_contents;
-    file_contents.resize(size);
-    in.read(&file_contents[0], size);
+    // Regular files are mapped and parsed in place, pipes are read in a buffer
+    mapped_file input;
+    if(!input.open(file)){
+        return false;
+    }
 
     auto& parser = x3_grammar::parser;
 
     x3_ast::source_file result;
     boost::spirit::x3::ascii::space_type space;
 
-    typedef std::string::iterator base_iterator_type;
-    typedef boost::spirit::classic::position_iterator2<base_iterator_type> pos_iterator_type;
+    // Plain iterators, the positions are only computed for the diagnostics
+    typedef mapped_file::iterator pos_iterator_type;
+
+    pos_iterator_type it = input.begin();
+    pos_iterator_type end = input.end();
 
-    pos_iterator_type it(file_contents.begin(), file_contents.end(), file);
-    pos_iterator_type end;
+    line_index lines(input.begin(), input.end(), file);
 
     try {
         bool r = x3::phrase_parse(it, end, parser, space, result);
@@ -120,9 +119,11 @@ bool parse(const std::string& file){
         if(r && it == end){
             return true;
         } else {
+            std::cout << lines.diagnostic(it - input.begin(), "error: unexpected input");
             return false;
         }
     } catch(const boost::spirit::x3::expectation_failure<pos_iterator_type>& e){
+        std::cout << lines.diagnostic(e.where() - input.begin(), "error: expected " + e.which());
         return false;
     }
 }
@@ -3,6 +3,8 @@
 #include <boost/spirit/home/x3.hpp>
 #include <boost/fusion/include/adapt_struct.hpp>
 
+#include "erased_parser.hpp"
+
 namespace x3 = boost::spirit::x3;
 
 namespace x3_ast {
@@ -37,7 +39,7 @@ namespace x3_grammar {
     typedef x3::identity<struct template_function_declaration> template_function_declaration_id;
     x3::rule<template_function_declaration_id, x3_ast::template_function_declaration> const template_function_declaration("template_function_declaration");
 
-    using parser_type = x3::any_parser<
+    using parser_type = erased_parser<
         std::string::iterator,
         x3_ast::simple_type
     >;